@@ -0,0 +1,138 @@
+// Display throughput benchmark.
+//
+// Prints one CSV line per measurement on Serial (115200 baud):
+//   bench,<board>,<i2c clock>,<geometry>,<metric>,<value>,<unit>
+// Lines starting with '#' are comments. Built with -DLCD_I2C_STATS=1, every
+// metric is followed by its transaction and byte counts per operation, so
+// runs can be diffed against a stored baseline.
+
+#include <Wire.h>
+#include <LiquidCrystal_I2C.h>
+#include <Arduino.h>
+
+#ifndef BENCH_ADDR
+    #define BENCH_ADDR 0x27
+#endif
+#ifndef BENCH_CLOCK
+    #define BENCH_CLOCK 100000
+#endif
+#ifndef BENCH_BOARD
+    #define BENCH_BOARD "unknown"
+#endif
+#ifndef BENCH_RUNS
+    #define BENCH_RUNS 20
+#endif
+
+// Both geometries drive the same panel; only the amount of data changes.
+LiquidCrystal_I2C lcd16(BENCH_ADDR, 16, 2);
+LiquidCrystal_I2C lcd20(BENCH_ADDR, 20, 4);
+
+static const char text[] = "0123456789ABCDEFGHIJ";
+static uint8_t bell[8] = { 0x04, 0x0e, 0x0e, 0x0e, 0x1f, 0x00, 0x04, 0x00 };
+
+static void report(const char* geometry, const char* metric, unsigned long value, const char* unit) {
+    Serial.print(F("bench," BENCH_BOARD ","));
+    Serial.print((unsigned long)BENCH_CLOCK);
+    Serial.print(',');
+    Serial.print(geometry);
+    Serial.print(',');
+    Serial.print(metric);
+    Serial.print(',');
+    Serial.print(value);
+    Serial.print(',');
+    Serial.println(unit);
+}
+
+#if LCD_I2C_STATS
+static void reportStats(LiquidCrystal_I2C& lcd, const char* geometry, const char* metric, unsigned long ops) {
+    const LCD::Stats& stats = lcd.getStats();
+    String name(metric);
+    report(geometry, (name + "_tx").c_str(), stats.transactions / ops, "tx/op");
+    report(geometry, (name + "_bytes").c_str(), stats.bytes / ops, "bytes/op");
+    unsigned long errors = 0;
+    for (uint8_t i = 0; i < 5; i++) {
+        errors += stats.errors[i];
+    }
+    report(geometry, (name + "_errors").c_str(), errors, "count");
+}
+    #define BENCH_START(lcd) lcd.resetStats()
+    #define BENCH_STATS(lcd, geometry, metric, ops) reportStats(lcd, geometry, metric, ops)
+#else
+    #define BENCH_START(lcd)
+    #define BENCH_STATS(lcd, geometry, metric, ops)
+#endif
+
+static void run(LiquidCrystal_I2C& lcd, const char* geometry, uint8_t cols, uint8_t rows) {
+    unsigned long start;
+
+    start = micros();
+    lcd.begin();
+    report(geometry, "begin", micros() - start, "us");
+    lcd.backlight();
+
+    // characters/second through print()
+    BENCH_START(lcd);
+    start = micros();
+    for (uint8_t n = 0; n < BENCH_RUNS; n++) {
+        lcd.setCursor(0, 0);
+        lcd.write((const uint8_t*)text, cols);
+    }
+    unsigned long elapsed = micros() - start;
+    report(geometry, "print", (unsigned long)BENCH_RUNS * cols * 1000000UL / elapsed, "chars/s");
+    BENCH_STATS(lcd, geometry, "print", BENCH_RUNS);
+
+    // every row addressed and rewritten
+    BENCH_START(lcd);
+    start = micros();
+    for (uint8_t n = 0; n < BENCH_RUNS; n++) {
+        for (uint8_t row = 0; row < rows; row++) {
+            lcd.setCursor(0, row);
+            lcd.write((const uint8_t*)text, cols);
+        }
+    }
+    report(geometry, "redraw", (micros() - start) / BENCH_RUNS, "us");
+    BENCH_STATS(lcd, geometry, "redraw", BENCH_RUNS);
+
+    BENCH_START(lcd);
+    start = micros();
+    for (uint8_t n = 0; n < BENCH_RUNS; n++) {
+        lcd.clear();
+    }
+    report(geometry, "clear", (micros() - start) / BENCH_RUNS, "us");
+    BENCH_STATS(lcd, geometry, "clear", BENCH_RUNS);
+
+    BENCH_START(lcd);
+    start = micros();
+    for (uint8_t n = 0; n < BENCH_RUNS; n++) {
+        lcd.home();
+    }
+    report(geometry, "home", (micros() - start) / BENCH_RUNS, "us");
+    BENCH_STATS(lcd, geometry, "home", BENCH_RUNS);
+
+    BENCH_START(lcd);
+    start = micros();
+    for (uint8_t n = 0; n < BENCH_RUNS; n++) {
+        lcd.createChar(n & 7, bell);
+    }
+    report(geometry, "createChar", (micros() - start) / BENCH_RUNS, "us");
+    BENCH_STATS(lcd, geometry, "createChar", BENCH_RUNS);
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+    }
+    Wire.begin();
+    // declares the clock to the driver, which also sets it on Wire, so the
+    // settle times and character packing are tuned to it
+    lcd16.setClock(BENCH_CLOCK);
+    lcd20.setClock(BENCH_CLOCK);
+
+    Serial.println(F("# bench,board,clock,geometry,metric,value,unit"));
+    run(lcd16, "16x2", 16, 2);
+    run(lcd20, "20x4", 20, 4);
+    Serial.println(F("# done"));
+}
+
+void loop() {
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+// Host stand-in for the parts of the Arduino core the library uses; time is
+// a fake clock (see host.h), so runs are deterministic
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+
+typedef uint8_t byte;
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define pgm_read_ptr(p) (*(void* const*)(p))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#define OUTPUT 1
+#define INPUT 0
+#define HIGH 1
+#define LOW 0
+
+unsigned long micros();
+unsigned long millis();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+#include "Print.h"
+
+class Stream: public Print {
+	public:
+		virtual int available() = 0;
+		virtual int read() = 0;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+class __FlashStringHelper;
+
+#define DEC 10
+#define HEX 16
+
+class Print {
+	public:
+		virtual ~Print() {}
+		virtual size_t write(uint8_t) = 0;
+		virtual size_t write(const uint8_t* buffer, size_t size) {
+			size_t n = 0;
+			while (size--) {
+				n += write(*buffer++);
+			}
+			return n;
+		}
+		size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+		size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+
+		size_t print(const __FlashStringHelper* str) { return write((const char*)str); }
+		size_t print(const char* str) { return write(str); }
+		size_t print(char c) { return write((uint8_t)c); }
+		size_t print(int value, int base = DEC) { return print((long)value, base); }
+		size_t print(unsigned value, int base = DEC) { return print((unsigned long)value, base); }
+		size_t print(long value, int base = DEC) {
+			char buf[24];
+			snprintf(buf, sizeof(buf), base == HEX ? "%lx" : "%ld", value);
+			return write(buf);
+		}
+		size_t print(unsigned long value, int base = DEC) {
+			char buf[24];
+			snprintf(buf, sizeof(buf), base == HEX ? "%lx" : "%lu", value);
+			return write(buf);
+		}
+		size_t print(double value, int digits = 2) {
+			char buf[32];
+			snprintf(buf, sizeof(buf), "%.*f", digits, value);
+			return write(buf);
+		}
+
+		size_t println() { return write("\r\n"); }
+		size_t println(const __FlashStringHelper* str) { return print(str) + println(); }
+		size_t println(const char* str) { return print(str) + println(); }
+		size_t println(int value, int base = DEC) { return print(value, base) + println(); }
+
+		virtual void flush() {}
+};
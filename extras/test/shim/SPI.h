@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+
+#define MSBFIRST 1
+#define SPI_MODE0 0
+
+struct SPISettings {
+	SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass {
+	public:
+		void begin() {}
+		void beginTransaction(SPISettings) {}
+		uint8_t transfer(uint8_t value) { return value; }
+		void endTransaction() {}
+};
+
+extern SPIClass SPI;
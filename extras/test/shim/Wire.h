@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BUFFER_LENGTH 32
+
+// Records every transaction in a host::Bus (see host.h) instead of driving pins
+class TwoWire {
+	public:
+		void begin() {}
+		void setClock(uint32_t) {}
+		void beginTransmission(uint8_t addr);
+		void beginTransmission(int addr) { beginTransmission((uint8_t)addr); }
+		size_t write(uint8_t value);
+		size_t write(int value) { return write((uint8_t)value); }
+		size_t write(const uint8_t* data, size_t size);
+		uint8_t endTransmission(bool stop = true);
+		uint8_t requestFrom(uint8_t addr, uint8_t size);
+		int available();
+		int read();
+};
+
+extern TwoWire Wire;
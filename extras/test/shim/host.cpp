@@ -0,0 +1,100 @@
+#include <Arduino.h>
+#include <Wire.h>
+#include <SPI.h>
+#include "host.h"
+
+TwoWire Wire;
+SPIClass SPI;
+
+namespace host {
+
+	static unsigned long clock = 0;
+	static std::vector<Transaction> records;
+	static Transaction pending;
+	static uint8_t failures = 0;
+	static uint8_t failstatus = 0;
+	static uint8_t readvalue = 0xff;
+
+	unsigned long now() {
+		return clock;
+	}
+
+	void advance(unsigned long us) {
+		clock += us;
+	}
+
+	void reset() {
+		clock = 0;
+		records.clear();
+		failures = 0;
+		readvalue = 0xff;
+	}
+
+	const std::vector<Transaction>& transactions() {
+		return records;
+	}
+
+	void fail(uint8_t count, uint8_t status) {
+		failures = count;
+		failstatus = status;
+	}
+
+	void setReadValue(uint8_t value) {
+		readvalue = value;
+	}
+
+} // namespace host
+
+unsigned long micros() {
+	return ++host::clock;
+}
+
+unsigned long millis() {
+	return host::clock / 1000;
+}
+
+void delay(unsigned long ms) {
+	host::clock += ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+	host::clock += us;
+}
+
+void TwoWire::beginTransmission(uint8_t addr) {
+	host::pending.addr = addr;
+	host::pending.bytes.clear();
+}
+
+size_t TwoWire::write(uint8_t value) {
+	host::pending.bytes.push_back(value);
+	return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t size) {
+	host::pending.bytes.insert(host::pending.bytes.end(), data, data + size);
+	return size;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+	host::pending.at = host::clock;
+	host::pending.status = 0;
+	if (host::failures) {
+		host::failures--;
+		host::pending.status = host::failstatus;
+	}
+	host::records.push_back(host::pending);
+	return host::pending.status;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t, uint8_t size) {
+	return size;
+}
+
+int TwoWire::available() {
+	return 1;
+}
+
+int TwoWire::read() {
+	return host::readvalue;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+// Test controls of the shim: the fake clock and the recorded Wire traffic
+namespace host {
+
+	struct Transaction {
+		uint8_t addr;
+		std::vector<uint8_t> bytes;
+		unsigned long at;    // micros() at endTransmission()
+		uint8_t status;      // what endTransmission() returned
+	};
+
+	// Every micros() call advances the clock by 1us, so busy loops terminate
+	unsigned long now();
+	void advance(unsigned long us);
+
+	// Clears the clock, the records and any injected failures
+	void reset();
+
+	const std::vector<Transaction>& transactions();
+
+	// The next count endTransmission() calls return status (2 address NAK, 3 data NAK)
+	void fail(uint8_t count, uint8_t status);
+
+	// Byte requestFrom()/read() returns
+	void setReadValue(uint8_t);
+
+} // namespace host
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdio.h>
+#include <string>
+#include <LiquidCrystal_I2C.h>
+#include <LiquidCrystal_I2C_Sim.h>
+#include "host.h"
+
+// Minimal checks for the host tests: failures are printed, main() returns their count
+static int test_failures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if (!(cond)) { \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+			test_failures++; \
+		} \
+	} while (0)
+
+#define CHECK_EQ(a, b) \
+	do { \
+		long long _a = (long long)(a), _b = (long long)(b); \
+		if (_a != _b) { \
+			printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+			test_failures++; \
+		} \
+	} while (0)
+
+#define CHECK_ROW(sim, cols, row, text) \
+	do { \
+		std::string _r = rowText(sim, cols, row); \
+		if (_r != (text)) { \
+			printf("%s:%d: row %d is \"%s\", expected \"%s\"\n", __FILE__, __LINE__, row, _r.c_str(), std::string(text).c_str()); \
+			test_failures++; \
+		} \
+	} while (0)
+
+// Characters of one row as the model shows them, codes outside ASCII as '#'
+static inline std::string rowText(LCD::SimTransport& sim, uint8_t cols, uint8_t row) {
+	const uint8_t offsets[] = { 0x00, 0x40, cols, (uint8_t)(0x40 + cols) };
+	std::string text;
+	for (uint8_t col = 0; col < cols; col++) {
+		uint8_t c = sim.ddram(offsets[row] + col);
+		text += c >= 0x20 && c < 0x7f ? (char)c : '#';
+	}
+	return text;
+}
+
+static inline int testResult() {
+	if (test_failures) {
+		printf("%d check(s) failed\n", test_failures);
+	}
+	return test_failures ? 1 : 0;
+}
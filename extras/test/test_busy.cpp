@@ -0,0 +1,56 @@
+// Busy flag polling: never slower than the fixed delay, faster where the bus
+// leaves room for a few status reads, and the screen stays correct either way
+#include "test.h"
+
+static unsigned long timeClear(uint32_t hz, bool poll, uint32_t& violations, bool& polling) {
+	host::reset();
+	LCD::SimTransport sim(hz);
+	LiquidCrystal_I2C lcd(sim, 16, 2);
+	lcd.setClock(hz);
+	lcd.setBusyPolling(poll);
+	lcd.begin();
+	polling = lcd.getBusyPolling();
+	lcd.print("busy");
+	unsigned long start = host::now();
+	lcd.clear();
+	lcd.print("ok");
+	unsigned long took = host::now() - start;
+	CHECK_ROW(sim, 16, 0, "ok              ");
+	violations = sim.violations();
+	return took;
+}
+
+static void testPolling() {
+	const uint32_t clocks[] = { 100000, 400000 };
+	for (uint32_t hz: clocks) {
+		uint32_t violations;
+		bool polling;
+		unsigned long fixed = timeClear(hz, false, violations, polling);
+		CHECK(!polling);
+		CHECK_EQ(violations, 0);
+		unsigned long polled = timeClear(hz, true, violations, polling);
+		CHECK_EQ(polling, hz == 400000);	// at 100kHz a status read does not pay
+		CHECK_EQ(violations, 0);
+		if (hz == 400000) {
+			CHECK(polled < fixed);
+		} else {
+			CHECK_EQ(polled, fixed);
+		}
+	}
+}
+
+// RW tied low: the probe reads a busy controller and keeps the fixed delays
+static void testProbeFails() {
+	host::reset();
+	host::setReadValue(0xff);
+	LiquidCrystal_I2C lcd(0x27, 16, 2);
+	lcd.setBusyPolling(true);
+	lcd.begin();
+	CHECK(!lcd.getBusyPolling());
+}
+
+int main() {
+	testPolling();
+	testProbeFails();
+	return testResult();
+}
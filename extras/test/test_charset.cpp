@@ -0,0 +1,65 @@
+// UTF-8 through setCharset(), built with LCD_I2C_CHARSET=1
+#include "test.h"
+
+static void testA00() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 20, 4);
+	lcd.begin();
+	lcd.setCharset(LCD::Charset::A00);
+	sim.resetCounters();
+	// degree, micro, a umlaut, voiced and semi-voiced katakana, then fallbacks and an emoji
+	lcd.print("25\xc2\xb0" "C \xc2\xb5s \xc3\xa4 \xe3\x82\xac\xe3\x83\x91 \\\xe2\x82\xac\xf0\x9f\x98\x80");
+	const uint8_t expected[] = { '2', '5', 0xdf, 'C', ' ', 0xe4, 's', ' ', 0xe1, ' ', 0xb6, 0xde, 0xca, 0xdf, ' ' };
+	for (uint8_t i = 0; i < sizeof(expected); i++) {
+		CHECK_EQ(sim.ddram(i), expected[i]);
+	}
+	CHECK(sim.ddram(15) < 8);	// backslash from CGRAM
+	CHECK(sim.ddram(16) < 8);	// euro from CGRAM
+	CHECK_EQ(sim.ddram(17), '?');
+	CHECK_EQ(sim.violations(), 0);
+
+	// sequences split across writes
+	lcd.setCursor(0, 1);
+	const char* text = "\xef\xbd\xb1\xe3\x82\xa2\xe2\x86\x92";
+	while (*text) {
+		lcd.write((uint8_t)*text++);
+	}
+	CHECK_EQ(sim.ddram(0x40), 0xb1);
+	CHECK_EQ(sim.ddram(0x41), 0xb1);
+	CHECK_EQ(sim.ddram(0x42), 0x7e);
+}
+
+static void testA02() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 16, 2);
+	lcd.begin();
+	lcd.setCharset(LCD::Charset::A02);
+	lcd.print("\xc3\x84\xc3\x9f~");
+	CHECK_EQ(sim.ddram(0), 0xc4);
+	CHECK_EQ(sim.ddram(1), 0xdf);
+	CHECK_EQ(sim.ddram(2), '~');
+}
+
+// the framebuffer sees the same codes as direct writes
+static void testFramebufferMatches() {
+	LCD::SimTransport direct;
+	LCD::SimTransport buffered;
+	LiquidCrystal_I2C a(direct, 16, 2);
+	LiquidCrystal_I2C b(buffered, 16, 2);
+	b.enableFramebuffer();
+	a.begin();
+	b.begin();
+	a.setCharset(LCD::Charset::A00);
+	b.setCharset(LCD::Charset::A00);
+	a.print(F("\xce\xb1\xce\xb2 \xc3\x84"));
+	b.print(F("\xce\xb1\xce\xb2 \xc3\x84"));
+	b.flush();
+	CHECK(direct.matches(buffered));
+}
+
+int main() {
+	testA00();
+	testA02();
+	testFramebufferMatches();
+	return testResult();
+}
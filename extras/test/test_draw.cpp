@@ -0,0 +1,81 @@
+// Bar graphs and big digits
+#include "test.h"
+
+static uint8_t countCode(LCD::SimTransport& sim, uint8_t start, uint8_t cols, uint8_t code) {
+	uint8_t n = 0;
+	for (uint8_t i = 0; i < cols; i++) {
+		n += sim.ddram(start + i) == code;
+	}
+	return n;
+}
+
+// the fill scales with the width actually drawn
+static void testBarWidth() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 20, 4);
+	lcd.begin();
+	lcd.drawBar(0, 0, 50, 200, 255);	// clamped to 20 cells: 78 of 100 pixels
+	CHECK_EQ(countCode(sim, 0x00, 20, 0xff), 15);
+	CHECK_EQ(sim.ddram(0x13), ' ');
+	CHECK_EQ(sim.ddram(0x14), ' ');	// row 2 untouched
+
+	lcd.drawBar(1, 15, 10, 255, 255);	// stops at the end of row 1
+	CHECK_EQ(countCode(sim, 0x40, 20, 0xff), 5);
+	CHECK_EQ(sim.ddram(0x54), ' ');	// row 3 untouched
+	CHECK_EQ(sim.violations(), 0);
+}
+
+static void testBigDigit() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 16, 2);
+	lcd.begin();
+	lcd.drawBigDigit(0, 0, 8);
+	CHECK_EQ(sim.ddram(0x00), 0xff);
+	CHECK_EQ(sim.ddram(0x02), 0xff);
+	CHECK_EQ(sim.ddram(0x40), 0xff);
+	CHECK_EQ(sim.ddram(0x42), 0xff);
+}
+
+// no DDRAM wrap into rows 2 and 3: the number is cut off after column 19
+static void testBigNumberClipped() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 20, 4);
+	lcd.begin();
+	lcd.drawBigNumber(0, 0, 123456);	// digits at 0, 4, 8, 12, 16: "6" does not fit
+	CHECK_EQ(sim.ddram(0x13), ' ');
+	CHECK_EQ(sim.ddram(0x53), ' ');
+	CHECK_EQ(countCode(sim, 0x14, 20, ' '), 20);	// row 2
+	CHECK_EQ(countCode(sim, 0x54, 20, ' '), 20);	// row 3
+	CHECK_EQ(sim.ddram(0x10), 0xff);	// left column of the "5"
+
+	// a digit starting at column 18 keeps two of its three columns
+	lcd.clear();
+	lcd.drawBigDigit(18, 0, 8);
+	CHECK_EQ(sim.ddram(0x12), 0xff);
+	CHECK_EQ(countCode(sim, 0x14, 20, ' '), 20);
+	CHECK_EQ(sim.violations(), 0);
+}
+
+// on the last row only the upper half is drawn, not over row 1 by a clamped setCursor()
+static void testBigDigitLastRow() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 16, 2);
+	lcd.begin();
+	lcd.drawBigDigit(0, 0, 8);
+	uint8_t upper = sim.ddram(0x01);
+	CHECK(upper != sim.ddram(0x41));
+	lcd.clear();
+	lcd.drawBigDigit(0, 1, 8);
+	CHECK_EQ(sim.ddram(0x40), 0xff);
+	CHECK_EQ(sim.ddram(0x41), upper);
+	CHECK_EQ(countCode(sim, 0x00, 16, ' '), 16);	// row 0 untouched
+	CHECK_EQ(sim.violations(), 0);
+}
+
+int main() {
+	testBarWidth();
+	testBigDigit();
+	testBigNumberClipped();
+	testBigDigitLastRow();
+	return testResult();
+}
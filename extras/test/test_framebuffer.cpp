@@ -0,0 +1,63 @@
+// present(), flush() and the glyph cache with the framebuffer enabled
+#include "test.h"
+
+static const uint8_t bell[8] PROGMEM = { 0x04, 0x0e, 0x0e, 0x0e, 0x1f, 0x00, 0x04, 0x00 };
+
+// after a swap _front is the upper half of the allocation
+static void testGlyphAfterSwap() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 20, 4);
+	lcd.enableFramebuffer();
+	lcd.begin();
+	lcd.print("hello");
+	lcd.present(true);
+	lcd.clear();
+	lcd.print("world");
+	uint8_t code = lcd.glyph_P(bell);
+	lcd.write(code);
+	lcd.present(true);
+	CHECK_ROW(sim, 20, 0, "world#              ");
+	CHECK_EQ(sim.ddram(5), code);
+	CHECK_EQ(sim.cgram(code * 8 + 4), 0x1f);
+
+	// a glyph shown in either buffer is never evicted
+	static uint8_t others[8][8];
+	for (uint8_t i = 0; i < 8; i++) {
+		others[i][0] = i + 1;
+		CHECK(lcd.glyph(others[i]) != code);
+	}
+	CHECK_EQ(sim.violations(), 0);
+}
+
+// flush() writes left to right whatever the entry mode; the tracked address must follow
+static void testRightToLeft() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 20, 4);
+	lcd.enableFramebuffer();
+	lcd.begin();
+	lcd.rightToLeft();
+	lcd.setCursor(0, 0);
+	lcd.print("A");
+	lcd.setCursor(19, 3);
+	lcd.print("B");
+	lcd.flush();
+	CHECK_ROW(sim, 20, 0, "A                   ");
+	CHECK_ROW(sim, 20, 3, "                   B");
+
+	// runs of several cells, and the mode is back to right-to-left after the flush
+	lcd.setCursor(10, 1);
+	lcd.print("abc");
+	lcd.flush();
+	CHECK_ROW(sim, 20, 1, "        cba         ");
+	lcd.disableFramebuffer();
+	lcd.setCursor(5, 2);
+	lcd.print("xy");
+	CHECK_ROW(sim, 20, 2, "    yx              ");
+	CHECK_EQ(sim.violations(), 0);
+}
+
+int main() {
+	testGlyphAfterSwap();
+	testRightToLeft();
+	return testResult();
+}
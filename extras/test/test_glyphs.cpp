@@ -0,0 +1,48 @@
+// createChar(), the glyph cache and recover()
+#include "test.h"
+
+// a createChar() array reused at the same address is uploaded again by glyph()
+static void testCreateCharAddressReuse() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 16, 2);
+	lcd.begin();
+	uint8_t bitmap[8];
+	memset(bitmap, 0x11, sizeof(bitmap));
+	lcd.createChar(3, bitmap);
+	CHECK_EQ(sim.cgram(3 * 8), 0x11);
+
+	memset(bitmap, 0x0a, sizeof(bitmap));
+	uint8_t code = lcd.glyph(bitmap);
+	CHECK_EQ(sim.cgram(code * 8), 0x0a);
+	CHECK_EQ(sim.cgram(code * 8 + 7), 0x0a);
+}
+
+static const uint8_t bell[8] PROGMEM = { 0x04, 0x0e, 0x0e, 0x0e, 0x1f, 0x00, 0x04, 0x00 };
+
+// recover() uploads the glyphs whose bitmaps are still valid, not createChar() ones
+static void testRecoverGlyphs() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 16, 2);
+	lcd.enableFramebuffer();
+	lcd.begin();
+	uint8_t temp[8] = { 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f };
+	lcd.createChar(0, temp);
+	uint8_t code = lcd.glyph_P(bell);
+	lcd.print("abc");
+	lcd.write(code);
+	lcd.flush();
+
+	sim.reset();	// power glitch: contents lost
+	CHECK(lcd.recover());
+	lcd.flush();
+	CHECK_ROW(sim, 16, 0, "abc#            ");
+	CHECK_EQ(sim.cgram(code * 8 + 4), 0x1f);
+	CHECK_EQ(sim.cgram(0), 0x00);
+	CHECK_EQ(sim.violations(), 0);
+}
+
+int main() {
+	testCreateCharAddressReuse();
+	testRecoverGlyphs();
+	return testResult();
+}
@@ -0,0 +1,67 @@
+// Four producer threads against one drain() loop; build with -DLCD_I2C_TSAN=ON
+// to run it under ThreadSanitizer
+#include "test.h"
+#include <LiquidCrystal_I2C_Mailbox.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static const int Updates = 2000;
+
+static void testProducers() {
+	LCD::SimTransport sim(400000);
+	LiquidCrystal_I2C lcd(sim, 20, 4);
+	lcd.setClock(400000);
+	lcd.begin();
+	LiquidCrystal_I2C_Mailbox<8> box(lcd);
+
+	std::atomic<int> done(0);
+	std::vector<std::thread> producers;
+	for (int task = 0; task < 4; task++) {
+		producers.emplace_back([&box, &done, task] {
+			char text[21];
+			for (int i = 0; i < Updates; i++) {
+				snprintf(text, sizeof(text), "task%d %06d", task, i);
+				while (!box.submit(0, task, text)) {
+					std::this_thread::yield();
+				}
+			}
+			done++;
+		});
+	}
+	unsigned drawn = 0;
+	while (done < 4) {
+		drawn += box.drain();
+	}
+	for (std::thread& t: producers) {
+		t.join();
+	}
+	drawn += box.drain();
+
+	CHECK_EQ(drawn, 4 * Updates);
+	// every row ends with its producer's last update
+	CHECK_ROW(sim, 20, 0, "task0 001999        ");
+	CHECK_ROW(sim, 20, 1, "task1 001999        ");
+	CHECK_ROW(sim, 20, 2, "task2 001999        ");
+	CHECK_ROW(sim, 20, 3, "task3 001999        ");
+	CHECK_EQ(sim.violations(), 0);
+}
+
+// a full queue refuses instead of blocking
+static void testFull() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 16, 2);
+	lcd.begin();
+	LiquidCrystal_I2C_Mailbox<2> box(lcd);
+	CHECK(box.submit(0, 0, "a"));
+	CHECK(box.submit(1, 0, "b"));
+	CHECK(!box.submit(2, 0, "c"));
+	CHECK_EQ(box.drain(), 2);
+	CHECK_ROW(sim, 16, 0, "ab              ");
+}
+
+int main() {
+	testProducers();
+	testFull();
+	return testResult();
+}
@@ -0,0 +1,80 @@
+// LiquidCrystal_I2C_Power: idle steps, PWM bus share, and staying off the bus
+#include "test.h"
+#include <LiquidCrystal_I2C_Power.h>
+
+static void testIdleSteps() {
+	host::reset();
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 16, 2);
+	lcd.begin();
+	LiquidCrystal_I2C_Power power(lcd);
+	power.setTimeouts(5000, 8000);
+	power.setDimLevel(64);
+	power.setDisplayOff(true);
+
+	uint32_t start = lcd.getTransactions();
+	uint32_t sleep = power.update();
+	CHECK(sleep > 4990 && sleep <= 5000);
+	CHECK_EQ(lcd.getTransactions(), start);
+
+	host::advance(sleep * 1000);
+	CHECK_EQ(power.update(), 0);	// PWM runs
+	CHECK_EQ(power.getState(), LCD::Power::Dim);
+
+	// the toggles stay within the default 10% of the bus
+	unsigned long began = host::now();
+	unsigned long busy = 0;
+	while (power.getState() == LCD::Power::Dim) {
+		unsigned long at = host::now();
+		uint32_t before = lcd.getTransactions();
+		if (power.update() == 0) {
+			host::advance(7);
+		}
+		if (lcd.getTransactions() != before) {
+			busy += host::now() - at;
+		}
+	}
+	CHECK(busy * 100 <= 11 * (host::now() - began));
+
+	// off: idle until the next activity()
+	uint32_t off = lcd.getTransactions();
+	CHECK_EQ(power.update(), 0xffffffff);
+	CHECK_EQ(lcd.getTransactions(), off);
+	CHECK(!lcd.getBacklight());
+	CHECK(!lcd.getDisplay());
+
+	host::advance(120000000UL);
+	power.update();
+	CHECK(power.wakeupsPerMinute() > 0);
+
+	power.activity();
+	CHECK_EQ(power.getState(), LCD::Power::Active);
+	CHECK(lcd.getBacklight());
+	CHECK(lcd.getDisplay());
+}
+
+// activity() does not undo the application's own noDisplay()
+static void testApplicationDisplayOff() {
+	for (int blank = 0; blank < 2; blank++) {
+		host::reset();
+		LCD::SimTransport sim;
+		LiquidCrystal_I2C lcd(sim, 16, 2);
+		lcd.begin();
+		LiquidCrystal_I2C_Power power(lcd);
+		power.setTimeouts(0, 1000);
+		power.setDisplayOff(blank);
+		lcd.noDisplay();
+		host::advance(2000000);
+		power.update();
+		CHECK_EQ(power.getState(), LCD::Power::Off);
+		power.activity();
+		CHECK(!lcd.getDisplay());
+		CHECK(lcd.getBacklight());
+	}
+}
+
+int main() {
+	testIdleSteps();
+	testApplicationDisplayOff();
+	return testResult();
+}
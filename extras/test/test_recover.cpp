@@ -0,0 +1,62 @@
+// recover() after a failed transaction puts the controller back as the
+// application left it, noDisplay() included
+#include "test.h"
+
+// NAKs the next few transactions, after the model has seen their bytes
+class FlakySim: public LCD::SimTransport {
+	public:
+		uint8_t fails = 0;
+
+		virtual uint8_t endWrite() {
+			uint8_t status = LCD::SimTransport::endWrite();
+			if (fails) {
+				fails--;
+				return 3;	// data NAK
+			}
+			return status;
+		}
+};
+
+static void testRecoverKeepsDisplayOff() {
+	FlakySim sim;
+	LiquidCrystal_I2C lcd(sim, 16, 2);
+	lcd.begin();
+	CHECK(sim.displayControl() & LCD::Control::On);
+	lcd.noDisplay();
+	sim.fails = 1;
+	lcd.print("x");
+	CHECK_EQ(lcd.getError(), 3);
+	CHECK(lcd.recover());
+	CHECK(!lcd.getDisplay());
+	CHECK(!(sim.displayControl() & LCD::Control::On));
+	CHECK_EQ(sim.violations(), 0);
+}
+
+// the same when present() recovers by itself
+static void testAutoRecoverKeepsDisplayOff() {
+	FlakySim sim;
+	LiquidCrystal_I2C lcd(sim, 16, 2);
+	lcd.enableFramebuffer();
+	lcd.setAutoRecover(true);
+	lcd.begin();
+	lcd.noDisplay();
+	sim.fails = 1;
+	lcd.print("x");
+	lcd.flush();
+	CHECK(lcd.getError() != 0);
+	lcd.print("y");
+	lcd.flush();
+	CHECK_EQ(lcd.getError(), 0);
+	CHECK_ROW(sim, 16, 0, "xy              ");
+	CHECK(!(sim.displayControl() & LCD::Control::On));
+
+	lcd.display();
+	CHECK(sim.displayControl() & LCD::Control::On);
+	CHECK_EQ(sim.violations(), 0);
+}
+
+int main() {
+	testRecoverKeepsDisplayOff();
+	testAutoRecoverKeepsDisplayOff();
+	return testResult();
+}
@@ -0,0 +1,54 @@
+// refresh() with setRefreshRate(): however often the framebuffer is written,
+// the bus sees at most one diffed flush per interval
+#include "test.h"
+
+static void testRateLimit() {
+	host::reset();
+	LCD::SimTransport sim(400000);
+	LiquidCrystal_I2C lcd(sim, 20, 4);
+	lcd.setClock(400000);
+	lcd.enableFramebuffer();
+	lcd.begin();
+	lcd.setRefreshRate(20);
+	sim.resetCounters();
+
+	// 20000 writes over one simulated second
+	int refreshes = 0;
+	for (int i = 0; i < 20000; i++) {
+		lcd.setCursor(0, 0);
+		lcd.print(i);
+		lcd.setCursor(10, 1);
+		lcd.print(i * 7);
+		if (lcd.refresh()) {
+			refreshes++;
+		}
+		host::advance(50);
+	}
+	lcd.flush();
+	CHECK_EQ(refreshes, 21);	// at 0ms, then every 50ms
+	CHECK_EQ(sim.transactions(), 88);
+	CHECK_ROW(sim, 20, 0, "19999               ");
+	CHECK_ROW(sim, 20, 1, "          139993    ");
+	CHECK_EQ(sim.violations(), 0);
+}
+
+// an unchanged frame sends nothing
+static void testIdle() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 16, 2);
+	lcd.enableFramebuffer();
+	lcd.begin();
+	lcd.print("static");
+	lcd.flush();
+	sim.resetCounters();
+	for (int i = 0; i < 10; i++) {
+		CHECK(lcd.refresh());
+	}
+	CHECK_EQ(sim.transactions(), 0);
+}
+
+int main() {
+	testRateLimit();
+	testIdle();
+	return testResult();
+}
@@ -0,0 +1,149 @@
+// The model itself, the shim Wire recording, and that every way of drawing
+// leaves the same contents behind
+#include "test.h"
+
+static void draw(LiquidCrystal_I2C& lcd) {
+	lcd.setCursor(0, 0);
+	lcd.print("Temp: 23.5 C");
+	lcd.setCursor(0, 1);
+	lcd.print("Humidity 45%");
+	lcd.setCursor(3, 2);
+	lcd.print("row two");
+	lcd.setCursor(18, 3);
+	lcd.print("Z");
+}
+
+static void testWireRecording() {
+	host::reset();
+	LiquidCrystal_I2C lcd(0x27, 16, 2);
+	lcd.begin();
+	size_t start = host::transactions().size();
+	lcd.print("hi");
+	CHECK(host::transactions().size() > start);
+	for (const host::Transaction& t: host::transactions()) {
+		CHECK_EQ(t.addr, 0x27);
+	}
+
+	// the recorded expander bytes decode to the same screen
+	LCD::SimTransport sim;
+	for (const host::Transaction& t: host::transactions()) {
+		sim.beginWrite();
+		for (uint8_t b: t.bytes) {
+			sim.write(b);
+		}
+		sim.endWrite();
+		while (sim.busy()) {
+		}
+	}
+	CHECK_ROW(sim, 16, 0, "hi              ");
+}
+
+static void testModesMatch() {
+	LCD::SimTransport ref;
+	LiquidCrystal_I2C lcd(ref, 20, 4);
+	lcd.setTransmitMode(LCD::Transmit::PerByte);
+	lcd.begin();
+	ref.resetCounters();
+	draw(lcd);
+	uint32_t perbyte = ref.transactions();
+	CHECK_ROW(ref, 20, 0, "Temp: 23.5 C        ");
+	CHECK_ROW(ref, 20, 3, "                  Z ");
+	CHECK_EQ(ref.violations(), 0);
+
+	const uint8_t modes[] = { LCD::Transmit::PerNibble, LCD::Transmit::PerSend };
+	for (uint8_t mode: modes) {
+		LCD::SimTransport sim;
+		LiquidCrystal_I2C other(sim, 20, 4);
+		other.setTransmitMode(mode);
+		other.begin();
+		sim.resetCounters();
+		draw(other);
+		CHECK(sim.matches(ref));
+		CHECK(sim.transactions() < perbyte);
+		CHECK_EQ(sim.violations(), 0);
+	}
+
+	for (int queue = 0; queue < 2; queue++) {
+		LCD::SimTransport sim(400000);
+		LiquidCrystal_I2C fb(sim, 20, 4);
+		fb.setClock(400000);
+		fb.enableFramebuffer();
+		if (queue) {
+			fb.enableQueue();
+		}
+		fb.begin();
+		draw(fb);
+		fb.flush();
+		while (fb.poll()) {
+		}
+		CHECK(sim.matches(ref));
+		CHECK_EQ(sim.violations(), 0);
+	}
+}
+
+// one instruction per character, plus the address
+static void testInstructionCount() {
+	LCD::SimTransport sim;
+	LiquidCrystal_I2C lcd(sim, 16, 2);
+	lcd.begin();
+	sim.resetCounters();
+	lcd.setCursor(2, 1);
+	lcd.print("abc");
+	CHECK_EQ(sim.instructions(), 4);
+}
+
+// with the fake clock two runs take exactly the same simulated time
+static void testDeterministic() {
+	unsigned long took[2];
+	uint32_t bytes[2];
+	for (int run = 0; run < 2; run++) {
+		host::reset();
+		LCD::SimTransport sim;
+		LiquidCrystal_I2C lcd(sim, 20, 4);
+		lcd.begin();
+		draw(lcd);
+		lcd.clear();
+		took[run] = host::now();
+		bytes[run] = sim.bytes();
+	}
+	CHECK_EQ(took[0], took[1]);
+	CHECK_EQ(bytes[0], bytes[1]);
+}
+
+// Wire.setClock(1000000) without setClock(): a character per transaction, as
+// two expander bytes no longer cover the execution time
+static void testUnknownFastClock() {
+	host::reset();
+	LCD::SimTransport sim(1000000);
+	LiquidCrystal_I2C lcd(sim, 20, 4);
+	lcd.begin();
+	draw(lcd);
+	CHECK_ROW(sim, 20, 0, "Temp: 23.5 C        ");
+	CHECK_ROW(sim, 20, 3, "                  Z ");
+	CHECK_EQ(sim.violations(), 0);
+}
+
+// with 8 data bits FunctionSet carries 0x10, which is no cursor move: the
+// setCursor() after it must not be taken as already there
+static void testEightBitFunctionSet() {
+	LCD::SimTransport sim(100000, 8);
+	LiquidCrystal_I2C lcd(sim, 16, 1);
+	lcd.begin();
+	lcd.setCursor(5, 0);
+	lcd.command(LCD::Command::FunctionSet | LCD::Function::Bit8);
+	lcd.setCursor(4, 0);
+	lcd.print("x");
+	CHECK_EQ(sim.ddram(0x04), 'x');
+	CHECK_EQ(sim.ddram(0x05), ' ');
+	CHECK_EQ(sim.violations(), 0);
+}
+
+int main() {
+	testWireRecording();
+	testModesMatch();
+	testInstructionCount();
+	testDeterministic();
+	testUnknownFastClock();
+	testEightBitFunctionSet();
+	return testResult();
+}
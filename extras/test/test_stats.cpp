@@ -0,0 +1,25 @@
+// Per-call statistics count API calls, not cells, so they compare across modes
+#include "test.h"
+
+static void testWriteCalls() {
+	for (int fb = 0; fb < 2; fb++) {
+		LCD::SimTransport sim;
+		LiquidCrystal_I2C lcd(sim, 16, 2);
+		if (fb) {
+			lcd.enableFramebuffer();
+		}
+		lcd.begin();
+		lcd.resetStats();
+		lcd.print("hello");
+		lcd.write('!');
+		lcd.print(F("flash"));
+		lcd.flush();
+		CHECK_EQ(lcd.getStats().write.calls, 3);
+		CHECK_ROW(sim, 16, 0, "hello!flash     ");
+	}
+}
+
+int main() {
+	testWriteCalls();
+	return testResult();
+}
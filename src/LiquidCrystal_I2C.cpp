@@ -2,8 +2,41 @@
 #include <inttypes.h>
 #include <Arduino.h>
 
+// _expanderval before anything was written, or after a failed transaction
+static constexpr uint16_t ExpanderUnknown = 0xffff;
+// _ddram before begin(), after createChar() without a known address, or while in CGRAM
+static constexpr uint8_t DDRAMUnknown = 0xff;
+// _marqueerow without a marquee, and while the whole display shifts
+static constexpr uint8_t MarqueeOff = 0xff;
+static constexpr uint8_t MarqueeShift = 0xfe;
+
+#if LCD_I2C_STATS
+// times one API call into its histogram
+class CallTimer {
+	public:
+		CallTimer(LCD::CallStats& stats): _stats(stats), _start(micros()) {}
+		~CallTimer() {
+			uint32_t us = micros() - _start;
+			uint8_t bin = 0;
+			for (uint32_t t = us >> 6; t && bin < 7; t >>= 1) {
+				bin++;
+			}
+			_stats.calls++;
+			_stats.micros += us;
+			if (_stats.histogram[bin] != 0xffff) {
+				_stats.histogram[bin]++;
+			}
+		}
+	private:
+		LCD::CallStats& _stats;
+		unsigned long _start;
+};
+	#define LCD_STATS_CALL(name) CallTimer calltimer(_stats.name)
+#else
+	#define LCD_STATS_CALL(name)
+#endif
+
 LiquidCrystal_I2C::LiquidCrystal_I2C(uint8_t lcd_addr, uint8_t lcd_cols, uint8_t lcd_rows, uint8_t charsize, TwoWire& wire):
-	_addr(lcd_addr),
 	_displayfunction(LCD::Function::Bit4 | LCD::Function::Lines1 | LCD::Function::Font5x8),
 	_displaycontrol(LCD::Control::On | LCD::Control::CursorOff | LCD::Control::BlinkOff),
 	_displaymode(LCD::Mode::Left | LCD::Mode::ShiftDecr),
@@ -11,15 +44,82 @@ LiquidCrystal_I2C::LiquidCrystal_I2C(uint8_t lcd_addr, uint8_t lcd_cols, uint8_t
 	_rows(lcd_rows),
 	_charsize(charsize),
 	_backlightval(LCD::Backlight::Off),
-	_Wire(wire)
-{}
+	_expanderval(ExpanderUnknown),
+	_framelen(0),
+	_eightbit(false),
+	_pinmap(nullptr),
+	_ddram(DDRAMUnknown),
+	_glyphs(),
+	_glyphlru{ 0, 1, 2, 3, 4, 5, 6, 7 },
+	_glyphflash(0),
+	_error(0),
+	_transactions(0),
+	_autorecover(false),
+	_transmitmode(LCD::Transmit::PerSend),
+	_bytemicros(0),
+	_busyrequest(false),
+	_busypoll(false),
+	_front(nullptr),
+	_back(nullptr),
+	_stale(false),
+	_blankcells(0),
+	_refreshms(0),
+	_refreshat(0),
+	_col(0),
+	_row(0),
+	_queue(nullptr),
+	_queuesize(0),
+	_queuehead(0),
+	_queuecount(0),
+	_sentat(0),
+	_wait(0),
+	_Wire(wire),
+	_wiretransport(lcd_addr, wire),
+	_transport(&_wiretransport),
+	_inflight(false),
+	_marquee(nullptr),
+#if LCD_I2C_CHARSET
+	_charset(LCD::Charset::Raw),
+	_utf8left(0),
+	_codepoint(0),
+#endif
+	_marqueerow(MarqueeOff),
+	_marqueelen(0),
+	_marqueepos(0),
+	_marqueeinterval(0),
+	_marqueeat(0)
+{
+#if LCD_I2C_STATS
+	resetStats();
+#endif
+}
+
+LiquidCrystal_I2C::LiquidCrystal_I2C(LCD::Transport& transport, uint8_t lcd_cols, uint8_t lcd_rows, uint8_t charsize):
+	LiquidCrystal_I2C(0, lcd_cols, lcd_rows, charsize)
+{
+	_transport = &transport;
+}
+
+LiquidCrystal_I2C::~LiquidCrystal_I2C() {
+	disableQueue();
+	disableFramebuffer();
+	free(_pinmap);
+}
 
 void LiquidCrystal_I2C::init() {
 	_Wire.begin();
 	begin();
 }
 
-void LiquidCrystal_I2C::begin() {
+void LiquidCrystal_I2C::begin(uint8_t start) {
+	// a 16-bit expander drives D0-D7 directly
+	_eightbit = _transport->dataBits() == 8;
+	if (_eightbit) {
+		_displayfunction |= LCD::Function::Bit8;
+	} else {
+		_displayfunction &= ~LCD::Function::Bit8;
+	}
+
 	if (_rows > 1) {
 		_displayfunction |= LCD::Function::Lines2; // 2-line display
 	}
@@ -32,25 +132,72 @@ void LiquidCrystal_I2C::begin() {
 	// SEE PAGE 45/46 FOR INITIALIZATION SPECIFICATION!
 	// according to datasheet, we need at least 40ms after power rises above 2.7V
 	// before sending commands. Arduino can turn on way befer 4.5V so we'll wait 50
-	delay(50);
-	expanderWrite(_backlightval);	// reset expanderand turn backlight off (Bit 8 =1)
-	delay(1000);
+	_expanderval = ExpanderUnknown;	// the expander may have been reset with the display
+	_error = 0;
+	_ddram = DDRAMUnknown;
+	if (start != LCD::Start::Warm) {
+		forgetGlyphs();	// CGRAM is random after power-on
+	}
+	if (start == LCD::Start::Cold) {
+		settle(50000UL);
+		expanderWrite(_backlightval);	// reset expanderand turn backlight off (Bit 8 =1)
+		settle(1000000UL);
+	} else if (start == LCD::Start::Fast) {
+		settle(41000UL);
+		expanderWrite(_backlightval);
+	} else {
+		expanderWrite(_backlightval);
+	}
 
+	// The 0x03 sequence forces 8-bit mode from any state, then 0x02 selects 4-bit.
+	// After power-on the internal reset needs > 4.1ms and > 100us. A powered controller
+	// runs each 0x03 as an ordinary FunctionSet, except that the first one may complete
+	// a half-sent byte into any instruction, so it has to allow for a 1.52ms ClearDisplay.
+	bool warm = (start == LCD::Start::Warm);
 	write4bits(0x03 << 4);
-	delayMicroseconds(4500);
+	settle(start == LCD::Start::Cold ? 4500 : (warm ? 1600 : 4200));
 	write4bits(0x03 << 4);
-	delayMicroseconds(4500);
+	settle(start == LCD::Start::Cold ? 4500 : (warm ? 0 : 150));
 	write4bits(0x03 << 4);
-	delayMicroseconds(150);
-	write4bits(0x02 << 4);
+	settle(warm ? 0 : 150);
+	if (!_eightbit) {
+		write4bits(0x02 << 4);
+	}
 
 	// set # lines, font size, etc.
 	command(LCD::Command::FunctionSet | _displayfunction);
 
-	display();
+	// RW may be tied to ground on the backpack, then the data pins read back
+	// as all ones; the busy flag can only be trusted if it reads back clear.
+	// A stray instruction from the probe is a SetDDRAMAddr, which only moves the cursor.
+	_busypoll = _busyrequest && !_queue && !(readStatus(false) & 0x80);
+	if (_busyrequest && !_queue) {
+		endStatus();
+	}
+
+	// a warm start shows the display as it was left, noDisplay() included
+	if (!warm) {
+		_displaycontrol |= LCD::Control::On;
+	}
+	command(LCD::Command::DisplayControl | _displaycontrol);
+
+	if (warm) {
+		// the glass keeps its contents, but the framebuffer cannot know them
+		command(LCD::Command::EntryModeSet | _displaymode);
+		if (_back) {
+			_stale = true;
+		}
+		return;
+	}
 
 	// clear it off
-	clear();
+	clearDisplay();
+	if (_back) {
+		memset(_front, ' ', _cols * _rows);
+		memset(_back, ' ', _cols * _rows);
+		_stale = false;
+		_col = _row = 0;
+	}
 
 	// set the entry mode
 	command(LCD::Command::EntryModeSet | _displaymode);
@@ -58,104 +205,248 @@ void LiquidCrystal_I2C::begin() {
 	home();
 }
 
+static const uint8_t row_offsets[] = { 0x00, 0x40, 0x14, 0x54 };
+
 /********** high level commands, for the user! */
 void LiquidCrystal_I2C::clear(){
-	command(LCD::Command::ClearDisplay);// clear display, set cursor position to zero
-	delayMicroseconds(2000);  // this command takes a long time!
+	LCD_STATS_CALL(clear);
+	if (_back) {
+		memset(_back, ' ', _cols * _rows);
+		_col = _row = 0;
+		return;
+	}
+	clearDisplay();
 }
 
 void LiquidCrystal_I2C::home(){
 	command(LCD::Command::ReturnHome);  // set cursor position to zero
-	delayMicroseconds(2000);  // this command takes a long time!
+	waitReady(2000);  // this command takes a long time!
+	_col = _row = 0;
 }
 
 void LiquidCrystal_I2C::setCursor(uint8_t col, uint8_t row){
-	int row_offsets[] = { 0x00, 0x40, 0x14, 0x54 };
-	if (row > _rows) {
+	LCD_STATS_CALL(setCursor);
+	if (row >= _rows) {
 		row = _rows-1;    // we count rows starting w/0
 	}
-	command(LCD::Command::SetDDRAMAddr | (col + row_offsets[row]));
+	if (_back) {
+		_col = col;
+		_row = row;
+		return;
+	}
+	uint8_t addr = address(col, row);
+	if (_ddram == addr) {
+		return;	// the address counter is already there
+	}
+	command(LCD::Command::SetDDRAMAddr | addr);
+}
+
+void LiquidCrystal_I2C::clearDisplay() {
+	command(LCD::Command::ClearDisplay);// clear display, set cursor position to zero
+	waitReady(2000);  // this command takes a long time!
+}
+
+// A status sample takes 7 bytes on the bus and ending the read 4 more; polling
+// only pays when a few samples fit into the fixed delay, so at 100kHz it stays off
+static constexpr uint8_t SampleBytes = 7;
+static constexpr uint8_t EndBytes = 4;
+
+// whether waitReady(us) polls rather than waiting the fixed delay
+bool LiquidCrystal_I2C::pollsWithin(uint16_t us) {
+	uint32_t bytes = 4 * (uint32_t)(SampleBytes + EndBytes);
+	return _busypoll && !_queue && _bytemicros && bytes * _bytemicros <= us;
+}
+
+// wait for the busy flag to clear; a sample is only started if it and the end
+// of the read fit into what is left of the fixed delay
+void LiquidCrystal_I2C::waitReady(uint16_t us) {
+	if (!pollsWithin(us)) {
+		settle(us);
+		return;
+	}
+	uint32_t sample = (uint32_t)SampleBytes * _bytemicros;
+	uint32_t end = (uint32_t)EndBytes * _bytemicros;
+	unsigned long start = micros();
+	uint8_t status = readStatus(false);
+	while (status & 0x80) {
+		unsigned long elapsed = micros() - start;
+		if (elapsed + sample + end > us) {
+			endStatus();
+			elapsed = micros() - start;
+			if (elapsed < us) {
+				settle(us - elapsed);
+			}
+			return;
+		}
+		status = readStatus(true);
+	}
+	endStatus();
+}
+
+uint8_t LiquidCrystal_I2C::address(uint8_t col, uint8_t row) {
+	return col + row_offsets[row];
 }
 
 // Turn the display on/off (quickly)
 void LiquidCrystal_I2C::noDisplay() {
-	_displaycontrol &= ~LCD::Control::On;
-	command(LCD::Command::DisplayControl | _displaycontrol);
+	displayControl(_displaycontrol & ~LCD::Control::On);
 }
 void LiquidCrystal_I2C::display() {
-	_displaycontrol |= LCD::Control::On;
-	command(LCD::Command::DisplayControl | _displaycontrol);
+	displayControl(_displaycontrol | LCD::Control::On);
 }
 
 // Turns the underline cursor on/off
 void LiquidCrystal_I2C::noCursor() {
-	_displaycontrol &= ~LCD::Control::CursorOn;
-	command(LCD::Command::DisplayControl | _displaycontrol);
+	displayControl(_displaycontrol & ~LCD::Control::CursorOn);
 }
 void LiquidCrystal_I2C::cursor() {
-	_displaycontrol |= LCD::Control::CursorOn;
-	command(LCD::Command::DisplayControl | _displaycontrol);
+	displayControl(_displaycontrol | LCD::Control::CursorOn);
 }
 
 // Turn on and off the blinking cursor
 void LiquidCrystal_I2C::noBlink() {
-	_displaycontrol &= ~LCD::Control::BlinkOn;
-	command(LCD::Command::DisplayControl | _displaycontrol);
+	displayControl(_displaycontrol & ~LCD::Control::BlinkOn);
 }
 void LiquidCrystal_I2C::blink() {
-	_displaycontrol |= LCD::Control::BlinkOn;
-	command(LCD::Command::DisplayControl | _displaycontrol);
+	displayControl(_displaycontrol | LCD::Control::BlinkOn);
 }
 
 // These commands scroll the display without changing the RAM
 void LiquidCrystal_I2C::scrollDisplayLeft(void) {
-	command(LCD::Shift::CursorMove | LCD::Shift::DisplayMove | LCD::Shift::MoveLeft);
+	command(LCD::Command::CursorShift | LCD::Shift::DisplayMove | LCD::Shift::MoveLeft);
 }
 void LiquidCrystal_I2C::scrollDisplayRight(void) {
-	command(LCD::Shift::CursorMove | LCD::Shift::DisplayMove | LCD::Shift::MoveRight);
+	command(LCD::Command::CursorShift | LCD::Shift::DisplayMove | LCD::Shift::MoveRight);
 }
 
 // This is for text that flows Left to Right
 void LiquidCrystal_I2C::leftToRight(void) {
-	_displaymode |= LCD::Mode::Left;
-	command(LCD::Command::EntryModeSet | _displaymode);
+	entryMode(_displaymode | LCD::Mode::Left);
 }
 
 // This is for text that flows Right to Left
 void LiquidCrystal_I2C::rightToLeft(void) {
-	_displaymode &= ~LCD::Mode::Left;
-	command(LCD::Command::EntryModeSet | _displaymode);
+	entryMode(_displaymode & ~LCD::Mode::Left);
 }
 
 // This will 'right justify' text from the cursor
 void LiquidCrystal_I2C::autoscroll(void) {
-	_displaymode |= LCD::Mode::ShiftIncr;
-	command(LCD::Command::EntryModeSet | _displaymode);
+	entryMode(_displaymode | LCD::Mode::ShiftIncr);
 }
 
 // This will 'left justify' text from the cursor
 void LiquidCrystal_I2C::noAutoscroll(void) {
-	_displaymode &= ~LCD::Mode::ShiftIncr;
-	command(LCD::Command::EntryModeSet | _displaymode);
+	entryMode(_displaymode & ~LCD::Mode::ShiftIncr);
 }
 
 // Allows us to fill the first 8 CGRAM locations
 // with custom characters
 void LiquidCrystal_I2C::createChar(uint8_t location, uint8_t charmap[]) {
+	LCD_STATS_CALL(createChar);
 	location &= 0x7; // we only have 8 locations 0-7
-	command(LCD::Command::SetCGRAMAddr | (location << 3));
-	for (int i=0; i<8; i++) {
-		write(charmap[i]);
+	uploadGlyph(location, charmap, false);
+	_glyphs[location] = nullptr;	// the array may be temporary; glyph() must not match its address later
+}
+
+void LiquidCrystal_I2C::createChar_P(uint8_t location, const uint8_t* charmap) {
+	LCD_STATS_CALL(createChar);
+	location &= 0x7;
+	uploadGlyph(location, charmap, true);
+}
+
+/*********** glyph cache */
+
+uint8_t LiquidCrystal_I2C::glyph(const uint8_t* bitmap) {
+	return cacheGlyph(bitmap, false);
+}
+
+uint8_t LiquidCrystal_I2C::glyph_P(const uint8_t* bitmap) {
+	return cacheGlyph(bitmap, true);
+}
+
+// Bitmaps are identified by address. The victim is the least recently used slot
+// that no framebuffer cell shows; without a framebuffer that is simply the LRU slot.
+uint8_t LiquidCrystal_I2C::cacheGlyph(const uint8_t* bitmap, bool flash) {
+	uint8_t victim = 0xff;
+	for (uint8_t i = 0; i < 8; i++) {
+		uint8_t slot = _glyphlru[i];
+		if (_glyphs[slot] == bitmap && ((_glyphflash >> slot) & 1) == flash) {
+			touchGlyph(i);
+			return slot;
+		}
+	}
+	for (uint8_t i = 8; i-- > 0; ) {
+		if (!glyphShown(_glyphlru[i])) {
+			victim = _glyphlru[i];
+			break;
+		}
+	}
+	if (victim == 0xff) {
+		victim = _glyphlru[7];	// every slot is on screen, one of them has to change
+	}
+	uploadGlyph(victim, bitmap, flash);
+	return victim;
+}
+
+// writes CGRAM, bypassing the framebuffer, and returns to the DDRAM address
+void LiquidCrystal_I2C::uploadGlyph(uint8_t slot, const uint8_t* bitmap, bool flash) {
+	uint8_t restore = _ddram;
+	command(LCD::Command::SetCGRAMAddr | (slot << 3));
+	sendData(bitmap, 8, flash);
+	if (restore != DDRAMUnknown) {
+		command(LCD::Command::SetDDRAMAddr | restore);
+	}
+	_glyphs[slot] = bitmap;
+	_glyphflash = flash ? (_glyphflash | (1 << slot)) : (_glyphflash & ~(1 << slot));
+	for (uint8_t i = 0; i < 8; i++) {
+		if (_glyphlru[i] == slot) {
+			touchGlyph(i);
+			break;
+		}
 	}
 }
 
-// Turn the (optional) backlight off/on
+// move the slot at position i of the LRU order to the front
+void LiquidCrystal_I2C::touchGlyph(uint8_t i) {
+	uint8_t slot = _glyphlru[i];
+	memmove(_glyphlru + 1, _glyphlru, i);
+	_glyphlru[0] = slot;
+}
+
+// character codes 0-7 and 8-15 both show CGRAM slots 0-7
+bool LiquidCrystal_I2C::glyphShown(uint8_t slot) {
+	if (!_back) {
+		return false;
+	}
+	// present(true) swaps the two halves of the allocation, so scan each buffer
+	uint16_t size = _cols * _rows;
+	for (uint16_t i = 0; i < size; i++) {
+		if ((_front[i] & ~0x08) == slot || (_back[i] & ~0x08) == slot) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void LiquidCrystal_I2C::forgetGlyphs() {
+	memset(_glyphs, 0, sizeof(_glyphs));
+	_glyphflash = 0;
+}
+
+// Turn the (optional) backlight off/on; every expander byte carries
+// the backlight bit, so once one went out there is nothing to resend
 void LiquidCrystal_I2C::noBacklight(void) {
+	if (_backlightval == LCD::Backlight::Off && _expanderval != ExpanderUnknown) {
+		return;
+	}
 	_backlightval=LCD::Backlight::Off;
 	expanderWrite(0);
 }
 
 void LiquidCrystal_I2C::backlight(void) {
+	if (_backlightval == LCD::Backlight::On && _expanderval != ExpanderUnknown) {
+		return;
+	}
 	_backlightval=LCD::Backlight::On;
 	expanderWrite(0);
 }
@@ -163,23 +454,922 @@ bool LiquidCrystal_I2C::getBacklight() {
   return _backlightval == LCD::Backlight::On;
 }
 
+bool LiquidCrystal_I2C::getDisplay() {
+	return _displaycontrol & LCD::Control::On;
+}
+
+uint8_t LiquidCrystal_I2C::getCols() {
+	return _cols;
+}
+
+uint8_t LiquidCrystal_I2C::getRows() {
+	return _rows;
+}
+
 
 /*********** mid level commands, for sending data/cmds */
 
+// DisplayControl/EntryModeSet only go out when the flags change
+void LiquidCrystal_I2C::displayControl(uint8_t control) {
+	if (control == _displaycontrol) {
+		return;
+	}
+	_displaycontrol = control;
+	command(LCD::Command::DisplayControl | _displaycontrol);
+}
+
+void LiquidCrystal_I2C::entryMode(uint8_t mode) {
+	if (mode == _displaymode) {
+		return;
+	}
+	_displaymode = mode;
+	command(LCD::Command::EntryModeSet | _displaymode);
+}
+
 inline void LiquidCrystal_I2C::command(uint8_t value) {
 	send(value, 0);
 }
 
-inline size_t LiquidCrystal_I2C::write(uint8_t value) {
+// write stats are taken here, once per call, whichever path the cells take
+size_t LiquidCrystal_I2C::write(uint8_t value) {
+	LCD_STATS_CALL(write);
+#if LCD_I2C_CHARSET
+	if (_charset) {
+		transcode(&value, 1);
+		return 1;
+	}
+#endif
+	return writeCell(value);
+}
+
+size_t LiquidCrystal_I2C::write(const uint8_t* buffer, size_t size) {
+	LCD_STATS_CALL(write);
+#if LCD_I2C_CHARSET
+	if (_charset) {
+		transcode(buffer, size);
+		return size;
+	}
+#endif
+	return writeCells(buffer, size);
+}
+
+// character codes, past the charset
+inline size_t LiquidCrystal_I2C::writeCell(uint8_t value) {
+	if (_back) {
+		// cells past the edge are not visible, so they are not mirrored
+		if (_col < _cols) {
+			_back[_row * _cols + _col] = value;
+		}
+		if (_displaymode & LCD::Mode::Left) {
+			_col++;
+		} else {
+			_col--;
+		}
+		return 1;
+	}
 	send(value, LCD::Pin::Rs); // Rs = 1, data
 	return 1;
 }
 
+size_t LiquidCrystal_I2C::writeCells(const uint8_t* buffer, size_t size) {
+	if (_back) {
+		for (size_t i = 0; i < size; i++) {
+			writeCell(buffer[i]);
+		}
+		return size;
+	}
+	sendData(buffer, size);
+	return size;
+}
+
+#if LCD_I2C_CHARSET
+/*********** character sets */
+
+// Code points first..first+count-1 show ROM codes rom..; mark follows as a second
+// cell (katakana with dakuten or handakuten on A00, which has them as separate marks)
+struct CodeRange {
+	uint16_t first;
+	uint8_t count;
+	uint8_t rom;
+	uint8_t mark;
+};
+
+static const CodeRange a00_ranges[] PROGMEM = {
+	{ 0x0020, 60, 0x20, 0 }, { 0x005d, 33, 0x5d, 0 }, { 0x00a2, 1, 0xec, 0 }, { 0x00a5, 1, 0x5c, 0 },
+	{ 0x00b0, 1, 0xdf, 0 }, { 0x00b5, 1, 0xe4, 0 }, { 0x00df, 1, 0xe2, 0 }, { 0x00e4, 1, 0xe1, 0 },
+	{ 0x00f1, 1, 0xee, 0 }, { 0x00f6, 1, 0xef, 0 }, { 0x00f7, 1, 0xfd, 0 }, { 0x00fc, 1, 0xf5, 0 },
+	{ 0x03a3, 1, 0xf6, 0 }, { 0x03a9, 1, 0xf4, 0 }, { 0x03b1, 1, 0xe0, 0 }, { 0x03b2, 1, 0xe2, 0 },
+	{ 0x03b5, 1, 0xe3, 0 }, { 0x03b8, 1, 0xf2, 0 }, { 0x03bc, 1, 0xe4, 0 }, { 0x03c0, 1, 0xf7, 0 },
+	{ 0x03c1, 1, 0xe6, 0 }, { 0x03c3, 1, 0xe5, 0 }, { 0x2126, 1, 0xf4, 0 }, { 0x2190, 1, 0x7f, 0 },
+	{ 0x2192, 1, 0x7e, 0 }, { 0x221a, 1, 0xe8, 0 }, { 0x221e, 1, 0xf3, 0 }, { 0x2588, 1, 0xff, 0 },
+	{ 0x3001, 1, 0xa4, 0 }, { 0x3002, 1, 0xa1, 0 }, { 0x300c, 2, 0xa2, 0 }, { 0x3099, 2, 0xde, 0 },
+	{ 0x30a1, 1, 0xa7, 0 }, { 0x30a2, 1, 0xb1, 0 }, { 0x30a3, 1, 0xa8, 0 }, { 0x30a4, 1, 0xb2, 0 },
+	{ 0x30a5, 1, 0xa9, 0 }, { 0x30a6, 1, 0xb3, 0 }, { 0x30a7, 1, 0xaa, 0 }, { 0x30a8, 1, 0xb4, 0 },
+	{ 0x30a9, 1, 0xab, 0 }, { 0x30aa, 2, 0xb5, 0 }, { 0x30ac, 1, 0xb6, 0xde }, { 0x30ad, 1, 0xb7, 0 },
+	{ 0x30ae, 1, 0xb7, 0xde }, { 0x30af, 1, 0xb8, 0 }, { 0x30b0, 1, 0xb8, 0xde },
+	{ 0x30b1, 1, 0xb9, 0 }, { 0x30b2, 1, 0xb9, 0xde }, { 0x30b3, 1, 0xba, 0 },
+	{ 0x30b4, 1, 0xba, 0xde }, { 0x30b5, 1, 0xbb, 0 }, { 0x30b6, 1, 0xbb, 0xde },
+	{ 0x30b7, 1, 0xbc, 0 }, { 0x30b8, 1, 0xbc, 0xde }, { 0x30b9, 1, 0xbd, 0 },
+	{ 0x30ba, 1, 0xbd, 0xde }, { 0x30bb, 1, 0xbe, 0 }, { 0x30bc, 1, 0xbe, 0xde },
+	{ 0x30bd, 1, 0xbf, 0 }, { 0x30be, 1, 0xbf, 0xde }, { 0x30bf, 1, 0xc0, 0 },
+	{ 0x30c0, 1, 0xc0, 0xde }, { 0x30c1, 1, 0xc1, 0 }, { 0x30c2, 1, 0xc1, 0xde },
+	{ 0x30c3, 1, 0xaf, 0 }, { 0x30c4, 1, 0xc2, 0 }, { 0x30c5, 1, 0xc2, 0xde }, { 0x30c6, 1, 0xc3, 0 },
+	{ 0x30c7, 1, 0xc3, 0xde }, { 0x30c8, 1, 0xc4, 0 }, { 0x30c9, 1, 0xc4, 0xde },
+	{ 0x30ca, 6, 0xc5, 0 }, { 0x30d0, 1, 0xca, 0xde }, { 0x30d1, 1, 0xca, 0xdf },
+	{ 0x30d2, 1, 0xcb, 0 }, { 0x30d3, 1, 0xcb, 0xde }, { 0x30d4, 1, 0xcb, 0xdf },
+	{ 0x30d5, 1, 0xcc, 0 }, { 0x30d6, 1, 0xcc, 0xde }, { 0x30d7, 1, 0xcc, 0xdf },
+	{ 0x30d8, 1, 0xcd, 0 }, { 0x30d9, 1, 0xcd, 0xde }, { 0x30da, 1, 0xcd, 0xdf },
+	{ 0x30db, 1, 0xce, 0 }, { 0x30dc, 1, 0xce, 0xde }, { 0x30dd, 1, 0xce, 0xdf },
+	{ 0x30de, 5, 0xcf, 0 }, { 0x30e3, 1, 0xac, 0 }, { 0x30e4, 1, 0xd4, 0 }, { 0x30e5, 1, 0xad, 0 },
+	{ 0x30e6, 1, 0xd5, 0 }, { 0x30e7, 1, 0xae, 0 }, { 0x30e8, 6, 0xd6, 0 }, { 0x30ef, 1, 0xdc, 0 },
+	{ 0x30f2, 1, 0xa6, 0 }, { 0x30f3, 1, 0xdd, 0 }, { 0x30f4, 1, 0xb3, 0xde },
+	{ 0x30f7, 1, 0xdc, 0xde }, { 0x30fa, 1, 0xa6, 0xde }, { 0x30fb, 1, 0xa5, 0 },
+	{ 0x30fc, 1, 0xb0, 0 }, { 0x4e07, 1, 0xfb, 0 }, { 0x5186, 1, 0xfc, 0 }, { 0x5343, 1, 0xfa, 0 },
+	{ 0xff61, 63, 0xa1, 0 },
+};
+
+// the upper half of A02 follows ISO 8859-1
+static const CodeRange a02_ranges[] PROGMEM = {
+	{ 0x0020, 95, 0x20, 0 }, { 0x00a0, 96, 0xa0, 0 },
+};
+
+// drawn through the glyph cache where the ROM lacks them, sorted by code point
+static const uint16_t fallback_codes[] PROGMEM = { 0x005c, 0x007e, 0x00c4, 0x00d6, 0x00dc, 0x20ac };
+static const uint8_t fallback_glyphs[][8] PROGMEM = {
+	{ 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00 },	// backslash
+	{ 0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00, 0x00 },	// tilde
+	{ 0x0a, 0x00, 0x0e, 0x11, 0x1f, 0x11, 0x11, 0x00 },	// A umlaut
+	{ 0x0a, 0x00, 0x0e, 0x11, 0x11, 0x11, 0x0e, 0x00 },	// O umlaut
+	{ 0x0a, 0x00, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00 },	// U umlaut
+	{ 0x06, 0x09, 0x1c, 0x08, 0x1c, 0x09, 0x06, 0x00 },	// euro
+};
+
+static constexpr uint32_t Unmappable = 0xffffffff;
+
+void LiquidCrystal_I2C::setCharset(uint8_t charset) {
+	_charset = charset;
+	_utf8left = 0;
+}
+
+// Decodes UTF-8 into character codes and writes them in runs of up to 20 cells
+void LiquidCrystal_I2C::transcode(const uint8_t* text, size_t size) {
+	const CodeRange* ranges = _charset == LCD::Charset::A00 ? a00_ranges : a02_ranges;
+	uint8_t count = _charset == LCD::Charset::A00
+		? sizeof(a00_ranges) / sizeof(a00_ranges[0]) : sizeof(a02_ranges) / sizeof(a02_ranges[0]);
+	uint8_t cells[20];
+	uint8_t n = 0;
+	for (size_t i = 0; i < size; i++) {
+		uint8_t c = text[i];
+		if (_utf8left && (c & 0xc0) == 0x80) {
+			_codepoint = (_codepoint << 6) | (c & 0x3f);
+			if (--_utf8left) {
+				continue;
+			}
+		} else {
+			if (_utf8left) {
+				cells[n++] = '?';	// truncated sequence, c starts the next one
+				_utf8left = 0;
+			}
+			if (c < 0x80) {
+				_codepoint = c;
+			} else if (c >= 0xc2 && c < 0xf5) {
+				_utf8left = c < 0xe0 ? 1 : c < 0xf0 ? 2 : 3;
+				_codepoint = c & (0x3f >> _utf8left);
+				continue;
+			} else {
+				_codepoint = Unmappable;	// stray continuation or invalid lead byte
+			}
+		}
+
+		uint32_t cp = _codepoint;
+		uint8_t rom = '?';
+		uint8_t mark = 0;
+		if (cp < 0x20) {
+			rom = cp;
+		} else if (cp <= 0xffff) {
+			// last range starting at or before cp
+			uint8_t lo = 0;
+			uint8_t hi = count;
+			while (hi - lo > 1) {
+				uint8_t mid = (lo + hi) / 2;
+				if (pgm_read_word(&ranges[mid].first) <= cp) {
+					lo = mid;
+				} else {
+					hi = mid;
+				}
+			}
+			uint16_t first = pgm_read_word(&ranges[lo].first);
+			if (cp >= first && cp - first < pgm_read_byte(&ranges[lo].count)) {
+				rom = pgm_read_byte(&ranges[lo].rom) + (cp - first);
+				mark = pgm_read_byte(&ranges[lo].mark);
+			} else {
+				for (uint8_t g = 0; g < sizeof(fallback_codes) / sizeof(fallback_codes[0]); g++) {
+					if (pgm_read_word(&fallback_codes[g]) == cp) {
+						rom = glyph_P(fallback_glyphs[g]);
+						break;
+					}
+				}
+			}
+		}
+		cells[n++] = rom;
+		if (mark) {
+			cells[n++] = mark;
+		}
+		if (n >= sizeof(cells) - 2) {
+			writeCells(cells, n);
+			n = 0;
+		}
+	}
+	if (n) {
+		writeCells(cells, n);
+	}
+}
+#endif
+
+/*********** flash strings */
+
+size_t LiquidCrystal_I2C::write_P(const uint8_t* buffer, size_t size) {
+	LCD_STATS_CALL(write);
+#if LCD_I2C_CHARSET
+	if (_charset) {
+		uint8_t chunk[20];
+		for (size_t done = 0; done < size; ) {
+			uint8_t n = size - done < sizeof(chunk) ? size - done : sizeof(chunk);
+			memcpy_P(chunk, buffer + done, n);
+			transcode(chunk, n);
+			done += n;
+		}
+		return size;
+	}
+#endif
+	if (_back) {
+		for (size_t i = 0; i < size; i++) {
+			writeCell(pgm_read_byte(buffer + i));
+		}
+		return size;
+	}
+	sendData(buffer, size, true);
+	return size;
+}
+
+size_t LiquidCrystal_I2C::print_P(const char* str) {
+	return write_P((const uint8_t*)str, strlen_P(str));
+}
+
+size_t LiquidCrystal_I2C::print(const __FlashStringHelper* str) {
+	return print_P((const char*)str);
+}
+
+size_t LiquidCrystal_I2C::println(const __FlashStringHelper* str) {
+	size_t n = print(str);
+	return n + println();
+}
+
+void LiquidCrystal_I2C::screen_P(const char* text) {
+	// find the rows first, they are sent in DDRAM order like flush() does
+	const char* rows[4];
+	uint8_t lengths[4];
+	uint8_t count = _rows < 4 ? _rows : 4;
+	for (uint8_t row = 0; row < count; row++) {
+		uint8_t len = 0;
+		char c;
+		while (len < _cols && (c = pgm_read_byte(text + len)) != '\0' && c != '\n') {
+			len++;
+		}
+		rows[row] = text;
+		lengths[row] = len;
+		text += len;
+		if (pgm_read_byte(text) == '\n') {
+			text++;
+		}
+	}
+	static const uint8_t order[] = { 0, 2, 1, 3 };
+	for (uint8_t i = 0; i < 4; i++) {
+		uint8_t row = order[i];
+		if (row >= count) {
+			continue;
+		}
+		uint8_t len = lengths[row];
+		if (_back) {
+			uint8_t* cells = _back + row * _cols;
+			for (uint8_t col = 0; col < _cols; col++) {
+				cells[col] = col < len ? pgm_read_byte(rows[row] + col) : ' ';
+			}
+			continue;
+		}
+		uint8_t addr = address(0, row);
+		if (_ddram != addr) {
+			command(LCD::Command::SetDDRAMAddr | addr);
+		}
+		sendData((const uint8_t*)rows[row], len, true);
+		sendPadded("", _cols - len);
+	}
+	if (_back) {
+		_col = _row = 0;
+	}
+}
+
+void LiquidCrystal_I2C::setTransmitMode(uint8_t mode) {
+	_transmitmode = mode;
+}
+
+void LiquidCrystal_I2C::setClock(uint32_t hz) {
+	_bytemicros = hz ? 9000000UL / hz : 0;	// 8 bits and the ack, rounded down
+	if (hz && _transport == &_wiretransport) {
+		_Wire.setClock(hz);
+	}
+}
+
+// The controller executes for 37us after the falling edge of En, which ends a transfer.
+// The next transfer raises En again only after its address byte and at least one more,
+// so that much of the settle time has already passed on the bus.
+uint16_t LiquidCrystal_I2C::settleTime(uint8_t bytes) {
+	uint16_t covered = bytes * _bytemicros;
+	return covered < 50 ? 50 - covered : 0;	// commands need > 37us to settle
+}
+
+void LiquidCrystal_I2C::setBusyPolling(bool enable) {
+	_busyrequest = enable;
+	if (!enable) {
+		_busypoll = false;
+	}
+}
+
+bool LiquidCrystal_I2C::getBusyPolling() {
+	return pollsWithin(2000);	// the delay of clear() and home()
+}
+
+
+/*********** framebuffer */
+
+bool LiquidCrystal_I2C::enableFramebuffer() {
+	if (_back) {
+		return true;
+	}
+	size_t size = _cols * _rows;
+	_front = (uint8_t*)malloc(2 * size);
+	if (!_front) {
+		return false;
+	}
+	_back = _front + size;
+	memset(_front, ' ', 2 * size);
+	_stale = true;
+	_col = _row = 0;
+	return true;
+}
+
+void LiquidCrystal_I2C::disableFramebuffer() {
+	free(_front < _back ? _front : _back);	// present() may have swapped them
+	_front = _back = nullptr;
+}
+
+void LiquidCrystal_I2C::flush() {
+	present(false);
+}
+
+void LiquidCrystal_I2C::setBlanking(uint8_t cells) {
+	_blankcells = cells;
+}
+
+void LiquidCrystal_I2C::setRefreshRate(uint8_t hz) {
+	_refreshms = hz ? 1000 / hz : 0;
+}
+
+bool LiquidCrystal_I2C::refresh() {
+	unsigned long now = millis();
+	if (!_back || (_refreshms && now - _refreshat < _refreshms)) {
+		return false;
+	}
+	_refreshat = now;
+	flush();	// an unchanged frame costs a compare, nothing on the bus
+	return true;
+}
+
+void LiquidCrystal_I2C::present(bool swap) {
+	if (!_back || _marqueerow == MarqueeShift) {
+		return;
+	}
+	if (_error && _autorecover) {
+		recover();	// marks the framebuffer stale, so this redraws everything
+	}
+	bool blank = false;
+	if (_blankcells && (_displaycontrol & LCD::Control::On)) {
+		size_t size = _cols * _rows;
+		size_t changed = 0;
+		for (size_t i = 0; i < size && changed < _blankcells; i++) {
+			changed += _stale || _front[i] != _back[i];
+		}
+		if (changed >= _blankcells) {
+			command(LCD::Command::DisplayControl | (_displaycontrol & ~LCD::Control::On));
+			blank = true;
+		}
+	}
+	// runs are written left to right; autoscroll would move the window under them
+	uint8_t entrymode = LCD::Mode::Left | LCD::Mode::ShiftDecr;
+	uint8_t usermode = _displaymode;
+	bool restoremode = false;
+	// writing through unchanged cells is cheaper than a new address while they
+	// take no more bytes than an extra transaction with a SetDDRAMAddr
+	uint8_t bridge = _eightbit ? 2 : 1;
+	// visit rows in DDRAM order (0, 2, 1, 3) so rows that follow on need no address
+	static const uint8_t order[] = { 0, 2, 1, 3 };
+	for (uint8_t i = 0; i < 4; i++) {
+		uint8_t row = order[i];
+		if (row >= _rows) {
+			continue;
+		}
+		uint8_t* front = _front + row * _cols;
+		uint8_t* back = _back + row * _cols;
+		uint8_t col = 0;
+		while (col < _cols) {
+			if (!_stale && front[col] == back[col]) {
+				col++;
+				continue;
+			}
+			uint8_t end = col + 1;
+			while (end < _cols) {
+				if (_stale || front[end] != back[end]) {
+					end++;
+					continue;
+				}
+				uint8_t next = end + 1;
+				while (next < _cols && front[next] == back[next]) {
+					next++;
+				}
+				if (next == _cols || next - end > bridge) {
+					break;
+				}
+				end = next + 1;
+			}
+			if (!restoremode && _displaymode != entrymode) {
+				// _displaymode follows, so trackAddress() counts in the direction in effect
+				_displaymode = entrymode;
+				command(LCD::Command::EntryModeSet | entrymode);
+				restoremode = true;
+			}
+			uint8_t addr = address(col, row);
+			if (_ddram != addr) {
+				command(LCD::Command::SetDDRAMAddr | addr);
+			}
+			sendData(back + col, end - col);
+			if (!swap) {
+				memcpy(front + col, back + col, end - col);
+			}
+			col = end;
+		}
+	}
+	_stale = false;
+	if (swap) {
+		uint8_t* glass = _back;
+		_back = _front;
+		_front = glass;
+	}
+	if (restoremode) {
+		_displaymode = usermode;
+		command(LCD::Command::EntryModeSet | _displaymode);
+	}
+	if (blank) {
+		command(LCD::Command::DisplayControl | _displaycontrol);
+	}
+	// leave the visible cursor where the mirror has it
+	if ((_displaycontrol & (LCD::Control::CursorOn | LCD::Control::BlinkOn)) && _col < _cols) {
+		uint8_t addr = address(_col, _row);
+		if (_ddram != addr) {
+			command(LCD::Command::SetDDRAMAddr | addr);
+		}
+	}
+}
+
+
+/*********** bar graphs and big digits */
+
+// partial bar cells, 1 to 4 of 5 pixel columns lit; 0 and 5 are ' ' and the ROM block
+static const uint8_t bar_glyphs[4][8] PROGMEM = {
+	{ 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 },
+	{ 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18 },
+	{ 0x1c, 0x1c, 0x1c, 0x1c, 0x1c, 0x1c, 0x1c, 0x1c },
+	{ 0x1e, 0x1e, 0x1e, 0x1e, 0x1e, 0x1e, 0x1e, 0x1e },
+};
+
+// strokes of the 3x2 digits: upper bar, lower bar, upper and lower bar
+static const uint8_t digit_glyphs[3][8] PROGMEM = {
+	{ 0x1f, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f },
+	{ 0x1f, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f },
+};
+
+// cells of each digit, top row then bottom row:
+// 0-2 digit_glyphs, 3 full block, 4 blank
+static const uint8_t digit_cells[10][6] PROGMEM = {
+	{ 3, 0, 3,  3, 1, 3 },	// 0
+	{ 0, 3, 4,  1, 3, 1 },	// 1
+	{ 2, 2, 3,  3, 1, 1 },	// 2
+	{ 2, 2, 3,  1, 1, 3 },	// 3
+	{ 3, 1, 3,  4, 4, 3 },	// 4
+	{ 3, 2, 2,  1, 1, 3 },	// 5
+	{ 3, 2, 2,  3, 1, 3 },	// 6
+	{ 0, 0, 3,  4, 4, 3 },	// 7
+	{ 3, 2, 3,  3, 1, 3 },	// 8
+	{ 3, 2, 3,  1, 1, 3 },	// 9
+};
+
+static constexpr uint8_t FullBlock = 0xff;	// character ROM, both A00 and A02
+
+void LiquidCrystal_I2C::drawBar(uint8_t row, uint8_t col, uint8_t width, uint16_t value, uint16_t max) {
+	uint8_t cells[40];
+	if (max == 0 || col >= _cols) {
+		return;
+	}
+	// clamp before scaling, and stop at the end of the row instead of wrapping into the next DDRAM line
+	if (width > _cols - col) {
+		width = _cols - col;
+	}
+	if (width > sizeof(cells)) {
+		width = sizeof(cells);
+	}
+	// the whole set stays resident, so later moves never upload
+	uint8_t codes[6];
+	codes[0] = ' ';
+	for (uint8_t i = 0; i < 4; i++) {
+		codes[i + 1] = glyph_P(bar_glyphs[i]);
+	}
+	codes[5] = FullBlock;
+	uint32_t pixels = (uint32_t)(value < max ? value : max) * width * 5 / max;
+	for (uint8_t i = 0; i < width; i++) {
+		uint8_t lit = pixels >= 5 ? 5 : pixels;
+		pixels -= lit;
+		cells[i] = codes[lit];
+	}
+	setCursor(col, row);
+	writeCells(cells, width);
+}
+
+void LiquidCrystal_I2C::printRow(uint8_t row, const char* text, uint8_t align) {
+	uint8_t cells[40];
+	uint8_t width = _cols < sizeof(cells) ? _cols : sizeof(cells);
+	uint8_t len = 0;
+	while (len < width && text[len]) {
+		len++;
+	}
+	uint8_t lead = 0;
+	if (align == LCD::Align::Right) {
+		lead = width - len;
+	} else if (align == LCD::Align::Center) {
+		lead = (width - len) / 2;
+	}
+	memset(cells, ' ', width);
+	memcpy(cells + lead, text, len);
+	if (row >= _rows) {
+		row = _rows - 1;
+	}
+	if (_back) {
+		memcpy(_back + row * _cols, cells, width);
+		_col = width;
+		_row = row;
+		return;
+	}
+	// row 0 runs on into row 2 and row 1 into row 3
+	uint8_t addr = address(0, row);
+	if (_ddram != addr) {
+		command(LCD::Command::SetDDRAMAddr | addr);
+	}
+	sendData(cells, width);
+}
+
+/*********** marquee */
+
+static constexpr uint8_t MarqueeGap = 4;	// blanks between the end of a row marquee and its start
+
+void LiquidCrystal_I2C::marquee(const char* line0, const char* line1, uint16_t interval) {
+	stopMarquee();
+	command(LCD::Command::ReturnHome);	// undo any shift
+	waitReady(2000);
+	// written straight to DDRAM, past the framebuffer
+	bool lines2 = _displayfunction & LCD::Function::Lines2;
+	command(LCD::Command::SetDDRAMAddr | 0x00);
+	sendPadded(line0, lines2 ? 40 : 80);
+	if (lines2) {
+		command(LCD::Command::SetDDRAMAddr | 0x40);
+		sendPadded(line1 ? line1 : "", 40);
+	}
+	_marqueerow = MarqueeShift;
+	_marqueeinterval = interval;
+	_marqueeat = millis();
+}
+
+void LiquidCrystal_I2C::marqueeRow(uint8_t row, const char* text, uint16_t interval) {
+	stopMarquee();
+	size_t len = strlen(text);
+	_marquee = text;
+	_marqueelen = len < 255 - MarqueeGap ? len : 255 - MarqueeGap;
+	_marqueepos = 0;
+	_marqueerow = row < _rows ? row : _rows - 1;
+	_marqueeinterval = interval;
+	_marqueeat = millis() - interval;	// the first step draws the row
+}
+
+bool LiquidCrystal_I2C::stepMarquee() {
+	unsigned long now = millis();
+	if (_marqueerow == MarqueeOff || now - _marqueeat < _marqueeinterval) {
+		return false;
+	}
+	// keep the pace, but do not catch up on steps missed by a slow loop()
+	_marqueeat = now - _marqueeat < 2UL * _marqueeinterval ? _marqueeat + _marqueeinterval : now;
+	if (_marqueerow == MarqueeShift) {
+		scrollDisplayLeft();
+		return true;
+	}
+	uint8_t cells[40];
+	uint8_t width = _cols < sizeof(cells) ? _cols : sizeof(cells);
+	uint8_t ring = _marqueelen + MarqueeGap;
+	for (uint8_t i = 0, pos = _marqueepos; i < width; i++) {
+		cells[i] = pos < _marqueelen ? _marquee[pos] : ' ';
+		pos = pos + 1 < ring ? pos + 1 : 0;
+	}
+	_marqueepos = _marqueepos + 1 < ring ? _marqueepos + 1 : 0;
+	setCursor(0, _marqueerow);
+	writeCells(cells, width);
+	if (_back) {
+		flush();
+	}
+	return true;
+}
+
+void LiquidCrystal_I2C::stopMarquee() {
+	if (_marqueerow == MarqueeShift) {
+		command(LCD::Command::ReturnHome);
+		waitReady(2000);
+		if (_back) {
+			_stale = true;	// DDRAM holds the marquee
+		}
+	}
+	_marqueerow = MarqueeOff;
+	_marquee = nullptr;
+}
+
+// text, then spaces up to width, in bulk writes
+void LiquidCrystal_I2C::sendPadded(const char* text, uint8_t width) {
+	uint8_t cells[20];
+	while (width > 0) {
+		uint8_t n = width < sizeof(cells) ? width : sizeof(cells);
+		for (uint8_t i = 0; i < n; i++) {
+			cells[i] = *text ? *text++ : ' ';
+		}
+		sendData(cells, n);
+		width -= n;
+	}
+}
+
+void LiquidCrystal_I2C::drawBigDigit(uint8_t col, uint8_t row, uint8_t digit) {
+	if (col >= _cols || row >= _rows) {
+		return;
+	}
+	// clipped like drawBar(): setCursor() clamps the row and DDRAM wraps past the last column
+	uint8_t width = _cols - col < 3 ? _cols - col : 3;
+	uint8_t halves = row + 1 < _rows ? 2 : 1;
+	uint8_t codes[5];
+	for (uint8_t i = 0; i < 3; i++) {
+		codes[i] = glyph_P(digit_glyphs[i]);
+	}
+	codes[3] = FullBlock;
+	codes[4] = ' ';
+	for (uint8_t half = 0; half < halves; half++) {
+		uint8_t cells[3];
+		for (uint8_t i = 0; i < width; i++) {
+			uint8_t c = digit > 9 ? 4 : pgm_read_byte(&digit_cells[digit][half * 3 + i]);
+			cells[i] = codes[c];
+		}
+		setCursor(col, row + half);
+		writeCells(cells, width);
+	}
+}
+
+void LiquidCrystal_I2C::drawBigNumber(uint8_t col, uint8_t row, uint32_t value, uint8_t digits) {
+	uint8_t buf[10];
+	uint8_t n = 0;
+	do {
+		buf[n++] = value % 10;
+		value /= 10;
+	} while (value > 0 && n < sizeof(buf));
+	if (digits == 0) {
+		digits = n;
+	}
+	// right aligned, one blank column between digits, leading positions blank
+	for (uint8_t i = 0; i < digits && col + i * 4 < _cols; i++) {
+		uint8_t pos = digits - 1 - i;
+		drawBigDigit(col + i * 4, row, pos < n ? buf[pos] : 0xff);
+	}
+}
+
+/*********** non-blocking queue */
+
+// entry flags besides LCD::Pin::Rs
+static constexpr uint8_t QueueNibble = 0x10;	// value is a single expander nibble
+static constexpr uint8_t QueueRaw    = 0x20;	// value is a raw expander byte
+static constexpr uint8_t QueueDelay  = 0x40;	// no transfer, only wait
+// waits above 32767us are stored in milliseconds
+static constexpr uint16_t WaitMillis = 0x8000;
+
+static uint16_t encodeWait(uint32_t us) {
+	if (us < WaitMillis) {
+		return us;
+	}
+	uint32_t ms = (us + 999) / 1000;
+	return WaitMillis | (ms < WaitMillis ? ms : WaitMillis - 1);
+}
+
+static uint32_t decodeWait(uint16_t wait) {
+	return (wait & WaitMillis) ? (uint32_t)(wait & ~WaitMillis) * 1000 : wait;
+}
+
+bool LiquidCrystal_I2C::enableQueue(uint8_t entries) {
+	if (_queue) {
+		return true;
+	}
+	if (entries == 0) {
+		return false;
+	}
+	_queue = (QueueEntry*)malloc(entries * sizeof(QueueEntry));
+	if (!_queue) {
+		return false;
+	}
+	_queuesize = entries;
+	_queuehead = _queuecount = 0;
+	_wait = 0;
+	return true;
+}
+
+void LiquidCrystal_I2C::disableQueue() {
+	if (!_queue) {
+		return;
+	}
+	while (poll()) {
+	}
+	free(_queue);
+	_queue = nullptr;
+}
+
+void LiquidCrystal_I2C::enqueue(uint8_t value, uint8_t flags, uint16_t wait) {
+	while (_queuecount == _queuesize) {
+		poll();
+	}
+	QueueEntry& e = _queue[(_queuehead + _queuecount) % _queuesize];
+	e.value = value;
+	e.flags = flags;
+	e.wait = wait;
+	_queuecount++;
+}
+
+// wait after the last transfer: blocking, or as a deadline in the queue
+void LiquidCrystal_I2C::settle(uint32_t us) {
+	if (!_queue) {
+#if LCD_I2C_STATS
+		_stats.delayMicros += us;
+#endif
+		if (us >= 1000) {
+			delay(us / 1000);
+			us %= 1000;
+		}
+		delayMicroseconds(us);
+		return;
+	}
+	if (_queuecount == 0) {
+		enqueue(0, QueueDelay, encodeWait(us));
+		return;
+	}
+	QueueEntry& last = _queue[(_queuehead + _queuecount - 1) % _queuesize];
+	last.wait = encodeWait(decodeWait(last.wait) + us);
+}
+
+bool LiquidCrystal_I2C::poll() {
+	if (!_queue) {
+		return false;
+	}
+	if (_inflight) {
+		if (_transport->busy()) {
+			return true;
+		}
+		// the settle time runs from the end of the transfer
+		_inflight = false;
+		_sentat = micros();
+	}
+	if (micros() - _sentat < _wait) {
+		return true;
+	}
+	_wait = 0;
+	if (_queuecount == 0) {
+		return false;
+	}
+	QueueEntry e = _queue[_queuehead];
+	_queuehead = (_queuehead + 1) % _queuesize;
+	_queuecount--;
+	if (!(e.flags & QueueDelay)) {
+		beginFrame();
+		if (e.flags & QueueRaw) {
+			pushPins(e.value | _backlightval);
+		} else if (e.flags & QueueNibble) {
+			pushNibble(e.value, true);
+		} else {
+			// like sendData(): follow-on bytes with short settle times share the frame
+			pushByte(e.value, e.flags);
+			size_t count = perFrame();
+			for (size_t n = 1; n < count && _queuecount > 0 && e.wait <= 50; n++) {
+				const QueueEntry& next = _queue[_queuehead];
+				if (next.flags & ~LCD::Pin::Rs) {
+					break;
+				}
+				e = next;
+				_queuehead = (_queuehead + 1) % _queuesize;
+				_queuecount--;
+				pushByte(e.value, e.flags);
+			}
+		}
+		endFrame();
+		_inflight = _transport->busy();
+	}
+	_sentat = micros();
+	_wait = decodeWait(e.wait);
+	return true;
+}
+
 
 /************ low level data pushing commands **********/
 
+// Six expander bytes per character (four in 8-bit mode), as many characters per frame
+// as the TX buffer holds once setClock() declared a clock up to about 480kHz. The next
+// character's setup byte keeps its En pulse two bytes (>= 44us at 400kHz) behind the
+// previous falling edge, which covers the 37us execution time.
+void LiquidCrystal_I2C::sendData(const uint8_t* buffer, size_t size, bool flash) {
+	if (_queue || (_transmitmode != LCD::Transmit::PerSend && !_eightbit)) {
+		while (size--) {
+			send(flash ? pgm_read_byte(buffer++) : *buffer++, LCD::Pin::Rs);
+		}
+		return;
+	}
+	size_t count = perFrame();
+	while (size > 0) {
+		size_t n = size < count ? size : count;
+		size -= n;
+		beginFrame();
+		while (n--) {
+			uint8_t value = flash ? pgm_read_byte(buffer++) : *buffer++;
+			trackAddress(value, LCD::Pin::Rs);
+			pushByte(value, LCD::Pin::Rs);
+		}
+		endFrame();
+		settle(settleTime(2));
+	}
+}
+
+// Follow the controller's address counter through every command and character;
+// an instruction is decoded by its highest set bit, as the controller does
+void LiquidCrystal_I2C::trackAddress(uint8_t value, uint8_t mode) {
+	if (mode & LCD::Pin::Rs) {
+		if (_ddram != DDRAMUnknown) {
+			_ddram = nextAddress(_ddram, _displaymode & LCD::Mode::Left);
+		}
+	} else if (value & LCD::Command::SetDDRAMAddr) {
+		_ddram = value & 0x7f;
+	} else if (value & LCD::Command::SetCGRAMAddr) {
+		_ddram = DDRAMUnknown;
+	} else if (value & LCD::Command::FunctionSet) {
+		// the interface and line flags (Bit8 is 0x10) leave the address alone
+	} else if (value & LCD::Command::CursorShift) {
+		if (!(value & LCD::Shift::DisplayMove) && _ddram != DDRAMUnknown) {
+			_ddram = nextAddress(_ddram, value & LCD::Shift::MoveRight);
+		}
+	} else if (value == LCD::Command::ClearDisplay || (value & ~0x01) == LCD::Command::ReturnHome) {
+		_ddram = 0;
+	}
+}
+
+// DDRAM is 0x00-0x4f in 1-line mode, 0x00-0x27 and 0x40-0x67 in 2-line mode
+uint8_t LiquidCrystal_I2C::nextAddress(uint8_t addr, bool forward) {
+	if (!(_displayfunction & LCD::Function::Lines2)) {
+		return forward ? (addr == 0x4f ? 0x00 : addr + 1) : (addr == 0x00 ? 0x4f : addr - 1);
+	}
+	if (forward) {
+		return addr == 0x27 ? 0x40 : (addr == 0x67 ? 0x00 : addr + 1);
+	}
+	return addr == 0x40 ? 0x27 : (addr == 0x00 ? 0x67 : addr - 1);
+}
+
 // write either command or data
 void LiquidCrystal_I2C::send(uint8_t value, uint8_t mode) {
+	trackAddress(value, mode);
+	if (_queue) {
+		enqueue(value, mode, settleTime(2));
+		return;
+	}
+	if (_transmitmode == LCD::Transmit::PerSend || _eightbit) {
+		// the controller only executes after the second nibble,
+		// so both can share one transaction and one settle time
+		beginFrame();
+		pushByte(value, mode);
+		endFrame();
+		settle(settleTime(2));
+		return;
+	}
 	uint8_t highnib=value&0xf0;
 	uint8_t lownib=(value<<4)&0xf0;
 	write4bits((highnib)|mode);
@@ -187,20 +1377,287 @@ void LiquidCrystal_I2C::send(uint8_t value, uint8_t mode) {
 }
 
 void LiquidCrystal_I2C::write4bits(uint8_t value) {
-	expanderWrite(value);
-	pulseEnable(value);
+	if (_queue) {
+		enqueue(value, QueueNibble, settleTime(2));
+		return;
+	}
+	if (_transmitmode == LCD::Transmit::PerByte && !_eightbit) {
+		expanderWrite(value);
+		pulseEnable(value);
+		return;
+	}
+	beginFrame();
+	pushNibble(value, true);
+	endFrame();
+	settle(settleTime(2));
 }
 
 void LiquidCrystal_I2C::expanderWrite(uint8_t data){
-	_Wire.beginTransmission(_addr);
-	_Wire.write((int)(data) | _backlightval);
-	_Wire.endTransmission();
+	if (_queue) {
+		enqueue(data, QueueRaw, 0);
+		return;
+	}
+	uint8_t out = data | _backlightval;
+	if (out == _expanderval) {
+		return;	// pins already at that level
+	}
+	beginFrame();
+	pushPins(out);
+	endFrame();
 }
 
 void LiquidCrystal_I2C::pulseEnable(uint8_t data){
 	expanderWrite(data | LCD::Pin::En);	// En high
-	delayMicroseconds(1);		// enable pulse must be >450ns
+	if (!_bytemicros) {
+		settle(1);		// enable pulse must be >450ns, a transfer takes longer
+	}
 
 	expanderWrite(data & ~LCD::Pin::En);	// En low
-	delayMicroseconds(50);		// commands need > 37us to settle
+	settle(settleTime(4));	// the next En pulse is two transfers away
+}
+
+// Reads the high status nibble with the busy flag (bit 7) and leaves En high.
+// The low nibble still needs its En pulse, but is not read: with more set, that
+// pulse of the previous sample and the next sample share one frame. endStatus()
+// ends the last sample. Returns 0xff if the expander does not answer.
+static constexpr uint8_t StatusIdle = 0xf0 | LCD::Pin::Rw;	// data pins released (quasi-bidirectional)
+
+uint8_t LiquidCrystal_I2C::readStatus(bool more) {
+	if (_eightbit) {
+		return 0xff;	// reading would mean turning port A around, not worth it
+	}
+	beginFrame();
+	if (more) {
+		pushPins(StatusIdle | _backlightval);	// En low: high nibble done
+		pushPins(StatusIdle | LCD::Pin::En | _backlightval);	// low nibble
+	}
+	pushPins(StatusIdle | _backlightval);	// Rw up before En
+	pushPins(StatusIdle | LCD::Pin::En | _backlightval);	// controller drives D4-D7
+	bool ok = endFrame();
+	uint8_t value = 0xff;
+	ok = _transport->read(value) && ok;
+	return ok ? datapins(value) : 0xff;
+}
+
+void LiquidCrystal_I2C::endStatus() {
+	if (_eightbit) {
+		return;
+	}
+	beginFrame();
+	pushPins(StatusIdle | _backlightval);
+	pushPins(StatusIdle | LCD::Pin::En | _backlightval);	// low nibble, unread
+	pushPins(StatusIdle | _backlightval);
+	endFrame();
+}
+
+/************ expander wiring **********/
+
+// Everything above works on the DFRobot layout (D4-D7 on P4-P7, Rs, Rw, En,
+// backlight on P0-P3); other wirings translate whole bytes through two lookups.
+void LiquidCrystal_I2C::setPinMap(uint8_t rs, uint8_t rw, uint8_t en, uint8_t backlight,
+		uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7) {
+	const uint8_t data[4] = { d4, d5, d6, d7 };
+	const uint8_t control[4] = { rs, rw, en, backlight };
+	bool identity = true;
+	for (uint8_t bit = 0; bit < 4; bit++) {
+		identity = identity && data[bit] == (0x10 << bit) && control[bit] == (0x01 << bit);
+	}
+	if (identity) {
+		free(_pinmap);
+		_pinmap = nullptr;
+		return;
+	}
+	if (!_pinmap) {
+		_pinmap = (uint8_t*)malloc(32);
+		if (!_pinmap) {
+			return;
+		}
+	}
+	for (uint8_t n = 0; n < 16; n++) {
+		uint8_t d = 0, c = 0;
+		for (uint8_t bit = 0; bit < 4; bit++) {
+			if (n & (1 << bit)) {
+				d |= data[bit];
+				c |= control[bit];
+			}
+		}
+		_pinmap[n] = d;			// high nibble: D4-D7
+		_pinmap[16 + n] = c;	// low nibble: Rs, Rw, En, backlight
+	}
+	_expanderval = ExpanderUnknown;
+}
+
+inline uint8_t LiquidCrystal_I2C::pinout(uint8_t value) {
+	if (!_pinmap) {
+		return value;
+	}
+	return _pinmap[value >> 4] | _pinmap[16 + (value & 0x0f)];
+}
+
+// D4-D7 read back from the expander, in the high nibble
+uint8_t LiquidCrystal_I2C::datapins(uint8_t value) {
+	if (!_pinmap) {
+		return value & 0xf0;
+	}
+	uint8_t nibble = 0;
+	for (uint8_t bit = 0; bit < 4; bit++) {
+		if (value & _pinmap[1 << bit]) {
+			nibble |= 0x10 << bit;
+		}
+	}
+	return nibble;
+}
+
+/************ batched transactions **********/
+
+void LiquidCrystal_I2C::beginFrame() {
+	_transport->beginWrite();
+	_framelen = 0;
+}
+
+// data, En high, En low; at any bus speed one byte on the wire
+// lasts longer than the 450ns enable pulse, so no delay is needed.
+// The data byte may be elided if the pins already hold it, but not between
+// two bytes in one frame: there it keeps the next En pulse clear of the
+// previous byte's execution time.
+void LiquidCrystal_I2C::pushNibble(uint8_t data, bool elide) {
+	if (_eightbit) {
+		pushWide(data & 0xf0, data & 0x0f, elide);	// init sequence: the low data bits are don't-care
+		return;
+	}
+	uint8_t out = (data & ~LCD::Pin::En) | _backlightval;
+	if (!elide || out != _expanderval) {
+		_transport->write(pinout(out));
+		_framelen++;
+	}
+	_transport->write(pinout(out | LCD::Pin::En));
+	_transport->write(pinout(out));
+	_framelen += 2;
+	_expanderval = out;
+}
+
+void LiquidCrystal_I2C::pushByte(uint8_t value, uint8_t mode) {
+	if (_eightbit) {
+		pushWide(value, mode, true);
+		return;
+	}
+	pushNibble((value&0xf0)|mode, _framelen == 0);
+	pushNibble(((value<<4)&0xf0)|mode, true);
+}
+
+// 8-bit mode: every write is a pair, port A (D0-D7) then port B (control pins).
+// The setup pair is only needed when the control pins change; otherwise the
+// data pair ahead of En high keeps the same two-byte gap as the 4-bit path.
+void LiquidCrystal_I2C::pushWide(uint8_t value, uint8_t mode, bool elide) {
+	uint8_t ctl = (mode & 0x0f & ~LCD::Pin::En) | _backlightval;
+	if (!elide || ctl != _expanderval) {
+		_transport->write(value);
+		_transport->write(pinout(ctl));
+		_framelen += 2;
+	}
+	_transport->write(value);
+	_transport->write(pinout(ctl | LCD::Pin::En));
+	_transport->write(value);
+	_transport->write(pinout(ctl));
+	_framelen += 4;
+	_expanderval = ctl;
+}
+
+// a single level change on the pins, with the data port cleared in 8-bit mode
+void LiquidCrystal_I2C::pushPins(uint8_t out) {
+	if (_eightbit) {
+		out &= 0x0f;
+		_transport->write((uint8_t)0x00);
+		_framelen++;
+	}
+	_transport->write(pinout(out));
+	_framelen++;
+	_expanderval = out;
+}
+
+// characters per transaction, leaving room for one setup write; the two bytes
+// between characters only cover the execution time up to about 480kHz, so
+// without a clock from setClock() every character gets its own transaction
+size_t LiquidCrystal_I2C::perFrame() {
+	if (!_bytemicros || 2 * _bytemicros < 37) {
+		return 1;
+	}
+	size_t capacity = _transport->capacity();
+	if (_eightbit) {
+		return capacity > 6 ? (capacity - 2) / 4 : 1;
+	}
+	return capacity / 6;
+}
+
+bool LiquidCrystal_I2C::endFrame() {
+#if LCD_I2C_STATS
+	unsigned long start = micros();
+#endif
+	uint8_t status = _transport->endWrite();
+	bool ok = status == 0;
+	_transactions++;
+	if (!ok) {
+		// the bytes may or may not have reached the pins
+		_expanderval = ExpanderUnknown;
+		_ddram = DDRAMUnknown;
+		_error = status;
+	}
+	if (!_queue) {
+		// blocking mode: settle times start when the bytes are out
+		while (_transport->busy()) {
+		}
+	}
+#if LCD_I2C_STATS
+	_stats.transactions++;
+	_stats.bytes += _framelen;
+	if (!_queue) {
+		_stats.busMicros += micros() - start;
+	}
+	if (!ok) {
+		_stats.errors[(status < 5 ? status : 5) - 1]++;
+	}
+#endif
+	return ok;
+}
+
+/************ error recovery **********/
+
+uint8_t LiquidCrystal_I2C::getError() {
+	return _error;
+}
+
+uint32_t LiquidCrystal_I2C::getTransactions() {
+	return _transactions;
+}
+
+void LiquidCrystal_I2C::setAutoRecover(bool enable) {
+	_autorecover = enable;
+}
+
+// A glitch may have left the controller between nibbles, or reset it along with
+// the expander; the warm sequence handles both, CGRAM is only random in the latter.
+bool LiquidCrystal_I2C::recover() {
+#if LCD_I2C_STATS
+	_stats.recoveries++;
+#endif
+	begin(LCD::Start::Warm);
+	for (uint8_t slot = 0; slot < 8; slot++) {
+		if (_glyphs[slot]) {
+			command(LCD::Command::SetCGRAMAddr | (slot << 3));
+			sendData(_glyphs[slot], 8, (_glyphflash >> slot) & 1);
+		}
+	}
+	return _error == 0;
+}
+
+#if LCD_I2C_STATS
+/************ statistics **********/
+
+const LCD::Stats& LiquidCrystal_I2C::getStats() {
+	return _stats;
+}
+
+void LiquidCrystal_I2C::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
 }
+#endif
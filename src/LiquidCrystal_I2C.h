@@ -4,6 +4,22 @@
 #include <inttypes.h>
 #include <Print.h>
 #include <Wire.h>
+#include "LiquidCrystal_I2C_Transport.h"
+
+// Default number of entries in the non-blocking command queue
+#ifndef LCD_I2C_QUEUE
+	#define LCD_I2C_QUEUE 32
+#endif
+
+// Set to 1 to collect bus and timing statistics, see LiquidCrystal_I2C::getStats()
+#ifndef LCD_I2C_STATS
+	#define LCD_I2C_STATS 0
+#endif
+
+// Set to 1 for UTF-8 text through LiquidCrystal_I2C::setCharset(); links the ROM tables
+#ifndef LCD_I2C_CHARSET
+	#define LCD_I2C_CHARSET 0
+#endif
 
 namespace LCD {
 	namespace Function {
@@ -49,6 +65,47 @@ namespace LCD {
 		constexpr byte Rs = 0x01; // Register Select
 	}
 
+	/*!
+	 * @brief Expander wiring of the DFRobot backpack, as bit masks on the PCF8574 port.
+	 *
+	 * Other backpacks are described by a struct with the same static members,
+	 * passed as the PinMap parameter of LiquidCrystal_I2C_T.
+	 */
+	struct DFRobotPins {
+		static constexpr byte Rs        = 0x01;
+		static constexpr byte Rw        = 0x02;
+		static constexpr byte En        = 0x04;
+		static constexpr byte Backlight = 0x08;
+		static constexpr byte D4        = 0x10;
+		static constexpr byte D5        = 0x20;
+		static constexpr byte D6        = 0x40;
+		static constexpr byte D7        = 0x80;
+	};
+
+	namespace Start {
+		constexpr byte Cold = 0x00; // legacy timings, with an extra second for slow power supplies
+		constexpr byte Fast = 0x01; // minimum power-on timings from the datasheet
+		constexpr byte Warm = 0x02; // display kept power (MCU reset, deep-sleep wakeup); contents kept
+	}
+
+	namespace Transmit {
+		constexpr byte PerByte   = 0x00; // one I2C transaction per expander byte (legacy)
+		constexpr byte PerNibble = 0x01; // data, EN high and EN low of a nibble in one transaction
+		constexpr byte PerSend   = 0x02; // both nibbles of a command/data byte in one transaction
+	}
+
+	namespace Align {
+		constexpr byte Left   = 0x00; // text at column 0, padded on the right
+		constexpr byte Center = 0x01; // padded on both sides, odd space on the right
+		constexpr byte Right  = 0x02; // text ends at the last column
+	}
+
+	namespace Charset {
+		constexpr byte Raw = 0x00; // bytes are character codes (default)
+		constexpr byte A00 = 0x01; // UTF-8 for the Japanese ROM: ASCII, katakana, some Greek
+		constexpr byte A02 = 0x02; // UTF-8 for the European ROM: ASCII, Latin-1
+	}
+
 	namespace Command {
 		constexpr byte ClearDisplay   = 0x01;
 		constexpr byte ReturnHome     = 0x02;
@@ -60,6 +117,31 @@ namespace LCD {
 		constexpr byte SetDDRAMAddr   = 0x80;
 	}
 
+	/*!
+	 * @brief Call count and durations of one API method.
+	 */
+	struct CallStats {
+		uint32_t calls;
+		uint32_t micros;        // total time spent in the method
+		uint16_t histogram[8];  // calls by duration: < 64us, < 128us, ... < 4096us, >= 4096us
+	};
+
+	/*!
+	 * @brief Counters collected when LCD_I2C_STATS is 1.
+	 */
+	struct Stats {
+		uint32_t transactions;  // expander transactions sent
+		uint32_t bytes;         // expander bytes in them
+		uint16_t errors[5];     // failed transactions by endTransmission() status 1-5
+		uint32_t busMicros;     // time until a transaction was out
+		uint32_t delayMicros;   // time in fixed settle delays
+		uint16_t recoveries;    // recover() calls
+		CallStats write;
+		CallStats clear;
+		CallStats setCursor;
+		CallStats createChar;
+	};
+
 } // namespace LCD
 
 
@@ -84,9 +166,21 @@ class LiquidCrystal_I2C: public Print {
 		LiquidCrystal_I2C(uint8_t lcd_addr, uint8_t lcd_cols, uint8_t lcd_rows, uint8_t charsize = LCD::Function::Font5x8, TwoWire& wire = Wire);
 
 		/**
-		 * @brief Destructor (does nothing).
+		 * @brief Constructor for a display behind a custom transport (e.g. a DMA backend).
+		 *
+		 * @param transport  Transport carrying the expander bytes; must outlive this object.
+		 * @param lcd_cols   Number of columns (characters per line) of the LCD display.
+		 * @param lcd_rows   Number of rows (lines) of the LCD display.
+		 * @param charsize   Character dot size; use LCD::Function::Font5x10 or LCD::Function::Font5x8.
+		 *
+		 * @note Busy flag polling needs a transport that can read().
+		 */
+		LiquidCrystal_I2C(LCD::Transport& transport, uint8_t lcd_cols, uint8_t lcd_rows, uint8_t charsize = LCD::Function::Font5x8);
+
+		/**
+		 * @brief Destructor; releases the framebuffer if one was enabled.
 		 */
-		~LiquidCrystal_I2C() = default;
+		~LiquidCrystal_I2C();
 
 		/**
 		 * @brief Compatibility function for legacy Arduino source codes.
@@ -101,13 +195,19 @@ class LiquidCrystal_I2C: public Print {
 		 * @brief Initializes the LCD display and prepares it for use.
 		 * 
 		 * This function must be called before using other LCD functions such as print(), write(), or clear().
+		 *
+		 * @param start  LCD::Start::Cold (default, over 1 s), LCD::Start::Fast (about 50 ms) or
+		 *               LCD::Start::Warm (about 2 ms; skips the power-on waits and leaves the
+		 *               display contents and the display() state alone, only use it when the
+		 *               display did not lose power).
 		 */
-		void begin();
+		void begin(uint8_t start = LCD::Start::Cold);
 
 		/**
 		 * @brief Clears all characters currently shown on the LCD.
 		 * 
 		 * The display will be empty, and the cursor will return to the (0,0) position.
+		 * With the framebuffer enabled only the mirror is cleared; flush() updates the display.
 		 */
 		void clear();
 
@@ -191,6 +291,21 @@ class LiquidCrystal_I2C: public Print {
 		 */
 		bool getBacklight();
 
+		/**
+		 * @brief Returns whether the display is on, as set by display() and noDisplay().
+		 */
+		bool getDisplay();
+
+		/**
+		 * @brief Returns the number of columns given to the constructor.
+		 */
+		uint8_t getCols();
+
+		/**
+		 * @brief Returns the number of rows given to the constructor.
+		 */
+		uint8_t getRows();
+
 		/**
 		 * @brief Enables automatic scrolling of the display when new text is printed.
 		 * 
@@ -211,8 +326,128 @@ class LiquidCrystal_I2C: public Print {
 		 */
 		void createChar(uint8_t, uint8_t[]);
 
+		/**
+		 * @brief Same as createChar(), for a bitmap stored in PROGMEM; it is sent straight from flash.
+		 */
+		void createChar_P(uint8_t location, const uint8_t* charmap);
+
+		/**
+		 * @brief Makes a custom character resident in CGRAM and returns its character code.
+		 *
+		 * Any number of bitmaps can be used; they share the 8 CGRAM slots, and a bitmap is only
+		 * uploaded when it is not resident already. The slot evicted is the least recently used
+		 * one not shown on screen (as far as the framebuffer knows). The DDRAM address is restored
+		 * after an upload, so glyph() can be called between setCursor() and write().
+		 *
+		 * @param bitmap  8 bytes defining the 5x8 dot pattern. Bitmaps are identified by address,
+		 *                so the array must stay alive and unchanged while in use.
+		 * @return Character code (0~7) to write().
+		 */
+		uint8_t glyph(const uint8_t* bitmap);
+
+		/**
+		 * @brief Same as glyph(), for a bitmap stored in PROGMEM.
+		 */
+		uint8_t glyph_P(const uint8_t* bitmap);
+
+		/**
+		 * @brief Draws a horizontal bar graph with single pixel column resolution.
+		 *
+		 * Uses 4 partial-fill glyphs through glyph_P(). With the framebuffer enabled,
+		 * flush() only sends the cells that changed, so moving the bar by one pixel
+		 * costs one character.
+		 *
+		 * @param row    Row of the bar.
+		 * @param col    First column of the bar.
+		 * @param width  Length of the bar in characters (5 pixels each), cut at the end of the row.
+		 * @param value  Fill level, 0 to max.
+		 * @param max    Value at which the bar is full.
+		 */
+		void drawBar(uint8_t row, uint8_t col, uint8_t width, uint16_t value, uint16_t max = 255);
+
+		/**
+		 * @brief Replaces a whole row with text, padded with spaces or truncated to the width.
+		 *
+		 * Sends the row in one bulk write, without an address command when the controller's
+		 * address counter already points at the row (e.g. row 2 after row 0 on a 20x4).
+		 * With the framebuffer enabled, only the row buffer is updated, and flush() sends
+		 * the cells that changed. Assumes left-to-right entry mode.
+		 *
+		 * @param row    Row to replace.
+		 * @param text   Text for the row.
+		 * @param align  LCD::Align::Left (default), LCD::Align::Center or LCD::Align::Right.
+		 */
+		void printRow(uint8_t row, const char* text, uint8_t align = LCD::Align::Left);
+
+		/**
+		 * @brief Starts scrolling the whole display with the controller's shift command.
+		 *
+		 * Each text is loaded once into a DDRAM line (40 characters, 80 on 1-line displays),
+		 * then every step costs a single command. The shift moves all rows together; on
+		 * a 4-row display the first line runs through rows 0 and 2, the second through 1 and 3.
+		 * flush() does nothing while it runs, and redraws everything after stopMarquee().
+		 *
+		 * @param line0     Text of the first line; the caller keeps it alive.
+		 * @param line1     Text of the second line, or nullptr for blank.
+		 * @param interval  Milliseconds per step.
+		 */
+		void marquee(const char* line0, const char* line1 = nullptr, uint16_t interval = 300);
+
+		/**
+		 * @brief Starts scrolling one row, the others stay in place.
+		 *
+		 * The shift command cannot move a single row, so each step rewrites the row;
+		 * with the framebuffer enabled it flushes, which sends only the cells that changed.
+		 *
+		 * @param row       Row to scroll.
+		 * @param text      Text of any length, followed by a short gap; the caller keeps it alive.
+		 * @param interval  Milliseconds per step.
+		 */
+		void marqueeRow(uint8_t row, const char* text, uint16_t interval = 300);
+
+		/**
+		 * @brief Advances the marquee when its interval has passed; call it from loop().
+		 * @retval true  A step was sent.
+		 * @retval false No marquee, or not due yet.
+		 */
+		bool stepMarquee();
+
+		/**
+		 * @brief Stops the marquee where it is; after marquee() the display shift is undone.
+		 */
+		void stopMarquee();
+
+		/**
+		 * @brief Draws a digit 3 columns wide and 2 rows high.
+		 *
+		 * Uses 3 glyphs through glyph_P() besides the ROM block, so it can be combined with drawBar().
+		 * Like drawBar(), it is clipped at the right edge, and on the last row only the upper
+		 * half is drawn.
+		 *
+		 * @param col    Left column of the digit.
+		 * @param row    Upper row of the digit.
+		 * @param digit  0-9; anything else blanks the digit.
+		 */
+		void drawBigDigit(uint8_t col, uint8_t row, uint8_t digit);
+
+		/**
+		 * @brief Draws a number with drawBigDigit(), right aligned, 4 columns per digit.
+		 *
+		 * Digits past the right edge are cut off, the lowest ones first.
+		 *
+		 * @param col     Left column of the number.
+		 * @param row     Upper row of the number.
+		 * @param value   Number to draw.
+		 * @param digits  Number of digit positions, leading ones blanked; 0 to fit the value.
+		 */
+		void drawBigNumber(uint8_t col, uint8_t row, uint32_t value, uint8_t digits = 0);
+
 		/**
 		 * @brief Sets the cursor to the specified position.
+		 *
+		 * Sends nothing when the address counter is already there, e.g. right after
+		 * writing the cell before it.
+		 *
 		 * @param col  Column position (0-based).
 		 * @param row  Row position (0-based).
 		 */
@@ -228,6 +463,71 @@ class LiquidCrystal_I2C: public Print {
 		 */
 		virtual size_t write(uint8_t);
 
+		/**
+		 * @brief Writes a run of characters to the display.
+		 *
+		 * In LCD::Transmit::PerSend mode the characters are packed into as few I2C
+		 * transactions as the transport's capacity allows (LCD_I2C_TX_BUFFER for Wire:
+		 * 5 per frame on AVR, 21 on ESP32). That needs a bus clock up to about 480kHz
+		 * declared with setClock(); otherwise each character is its own transaction.
+		 *
+		 * @param buffer  Characters to write.
+		 * @param size    Number of characters in buffer.
+		 * @return The number of bytes written.
+		 *
+		 * @note Overrides the write() method from Arduino's Print class, so print() of strings uses it.
+		 */
+		virtual size_t write(const uint8_t*, size_t);
+		using Print::write;
+
+#if LCD_I2C_CHARSET
+		/**
+		 * @brief Makes write() and print() take UTF-8 text for the controller's character ROM.
+		 *
+		 * Sequences are decoded across calls, so text may arrive byte by byte. Code points are
+		 * looked up in a table in flash; those the ROM lacks are drawn with a built-in bitmap
+		 * through glyph_P() (backslash and tilde on A00, umlaut capitals, the euro sign), else
+		 * as '?'. Codes below 0x20 are passed on, so glyph() codes keep working. The characters
+		 * still go out in bulk writes; only screen_P(), printRow() and marquees take raw codes.
+		 *
+		 * Only built with LCD_I2C_CHARSET set to 1, so other sketches do not link the tables.
+		 *
+		 * @param charset  LCD::Charset::Raw, A00 or A02.
+		 */
+		void setCharset(uint8_t charset);
+#endif
+
+		/**
+		 * @brief Same as write(const uint8_t*, size_t), for characters stored in PROGMEM.
+		 *
+		 * The characters are read from flash as they are packed into the transaction, without
+		 * a copy in RAM.
+		 */
+		size_t write_P(const uint8_t* buffer, size_t size);
+
+		/**
+		 * @brief Prints a PROGMEM string (PSTR() or a PROGMEM char array) through write_P().
+		 */
+		size_t print_P(const char* str);
+
+		/**
+		 * @brief Prints an F() string through write_P() instead of one write() per character.
+		 */
+		size_t print(const __FlashStringHelper* str);
+		size_t println(const __FlashStringHelper* str);
+		using Print::print;
+		using Print::println;
+
+		/**
+		 * @brief Replaces the whole screen with a template stored in PROGMEM.
+		 *
+		 * The template holds the rows one after another, each ended by '\n' or by reaching
+		 * the width; rows are padded with spaces, rows after the terminating '\0' are blanked.
+		 *
+		 * @param text  Template, e.g. a PROGMEM char array "Menu\n> Start\n  Setup".
+		 */
+		void screen_P(const char* text);
+
 		/**
 		 * @brief Sends a raw command to the LCD controller.
 		 * @param value  Command byte to send.
@@ -236,14 +536,273 @@ class LiquidCrystal_I2C: public Print {
 		 */
 		void command(uint8_t);
 
+		/**
+		 * @brief Enables the RAM mirror of the display contents.
+		 *
+		 * Allocates two buffers of cols × rows bytes: one for the characters on the glass and
+		 * one for the characters written since. While enabled, write(), setCursor() and clear()
+		 * only update the mirror, and flush() sends the cells that changed.
+		 * May be called before or after begin(); the first flush() after begin() is a diff,
+		 * otherwise the whole screen is redrawn once.
+		 *
+		 * @retval true  Framebuffer is enabled.
+		 * @retval false Not enough memory.
+		 */
+		bool enableFramebuffer();
+
+		/**
+		 * @brief Disables and releases the framebuffer; pending changes are discarded.
+		 */
+		void disableFramebuffer();
+
+		/**
+		 * @brief Sends the cells that differ from what is on the display.
+		 *
+		 * Consecutive changed cells are sent as one run behind a single SetDDRAMAddr command;
+		 * runs that follow on in DDRAM (also across rows) need no address command at all.
+		 * Does nothing when the framebuffer is disabled.
+		 *
+		 * @note Overrides the flush() method from Arduino's Print class.
+		 */
+		virtual void flush();
+
+		/**
+		 * @brief Sends the delta like flush(), optionally swapping the buffers instead of copying.
+		 *
+		 * With swap, the buffer that was just sent becomes the mirror of the glass and the
+		 * application continues in the other one, which holds the frame before: it has to
+		 * redraw everything (e.g. clear() and draw) before the next present().
+		 *
+		 * @param swap  true to swap the buffers, false to keep drawing on the current frame.
+		 */
+		void present(bool swap = false);
+
+		/**
+		 * @brief Blanks the display while present() sends a large delta.
+		 *
+		 * The controller keeps DDRAM while the display is off, so the new frame appears at once
+		 * instead of row by row, at the cost of a short blank.
+		 *
+		 * @param cells  Minimum changed cells to blank for, 0 to never blank (default).
+		 */
+		void setBlanking(uint8_t cells);
+
+		/**
+		 * @brief Caps how often refresh() sends the framebuffer.
+		 *
+		 * Liquid crystal takes about 200ms to settle, so faster updates are never seen;
+		 * everything written between two refreshes costs one diffed flush.
+		 *
+		 * @param hz  Maximum refreshes per second, 0 for no limit (default).
+		 */
+		void setRefreshRate(uint8_t hz);
+
+		/**
+		 * @brief Flushes the framebuffer if the refresh interval has passed; call it from loop().
+		 *
+		 * Writes may come from anywhere in between, they only touch the framebuffer.
+		 *
+		 * @retval true  A refresh was due and the delta was sent.
+		 * @retval false Not due yet, or the framebuffer is disabled.
+		 */
+		bool refresh();
+
+		/**
+		 * @brief Returns the status of the last failed transaction since begin() or recover().
+		 * @return 0 if all went out, else the endTransmission() status (2 address NAK, 3 data NAK,
+		 *         5 timeout on cores with Wire timeouts).
+		 */
+		uint8_t getError();
+
+		/**
+		 * @brief Returns the number of transactions sent since construction, each one a bus wakeup.
+		 */
+		uint32_t getTransactions();
+
+		/**
+		 * @brief Brings the controller back in step after a failed transaction.
+		 *
+		 * Runs the warm begin() sequence, which resynchronizes the 4-bit interface from any
+		 * state, and uploads the CGRAM glyphs again that are still known: those of glyph(),
+		 * glyph_P() and createChar_P() (createChar() arrays may be gone). A display turned off
+		 * with noDisplay() stays off. With the framebuffer enabled, the next flush() redraws
+		 * the whole screen.
+		 *
+		 * @retval true  The recovery went out without errors.
+		 * @retval false The display still does not answer.
+		 */
+		bool recover();
+
+		/**
+		 * @brief Lets flush() call recover() by itself when a transaction has failed.
+		 * @param enable  true to recover automatically, false to only report through getError() (default).
+		 */
+		void setAutoRecover(bool);
+
+		/**
+		 * @brief Selects how expander bytes are grouped into I2C transactions.
+		 *
+		 * @param mode  LCD::Transmit::PerByte, LCD::Transmit::PerNibble or LCD::Transmit::PerSend (default).
+		 *
+		 * @note PerByte reproduces the legacy behaviour and is the only mode that routes
+		 *       through the virtual expanderWrite()/pulseEnable() hooks.
+		 */
+		void setTransmitMode(uint8_t);
+
+		/**
+		 * @brief Tells the driver the I2C clock, so it can drop waits the transfers already cover.
+		 *
+		 * The driver allows 50us for the controller's 37us execution time and subtracts the
+		 * bytes the next transfer sends before its En pulse. At 100kHz (90us per byte) nothing
+		 * is left to wait; at 400kHz (22us per byte) 6us remain after each run of packed
+		 * characters. Above about 480kHz characters no longer share a transaction, and without
+		 * a clock each one gets its own with the full delay. With the default transport the
+		 * clock is also applied to the Wire bus.
+		 *
+		 * @param hz  Bus clock in Hz, or 0 for unknown: fixed delays (default).
+		 */
+		void setClock(uint32_t hz);
+
+		/**
+		 * @brief Waits on the controller's busy flag instead of fixed delays for clear() and home().
+		 *
+		 * The busy flag is read through the RW pin. Whether RW is actually wired is probed in
+		 * begin(), so call this before begin(); on backpacks with RW tied to ground the fixed
+		 * delays stay in use.
+		 *
+		 * A status read costs 7 bytes on the bus, so polling only engages when setClock()
+		 * gives a clock fast enough for several reads within the fixed delay (400kHz, not
+		 * 100kHz); otherwise the fixed delay is kept. It never waits longer than that delay.
+		 *
+		 * @param enable  true to poll the busy flag when available, false for fixed delays.
+		 */
+		void setBusyPolling(bool);
+
+		/**
+		 * @brief Returns whether clear() and home() actually poll the busy flag.
+		 * @retval true  Polling was requested, the probe in begin() succeeded and the clock
+		 *               from setClock() leaves room for it.
+		 * @retval false Fixed delays are used.
+		 */
+		bool getBusyPolling();
+
+		/**
+		 * @brief Sets the expander wiring for backpacks that differ from the DFRobot layout.
+		 *
+		 * Each parameter is the bit mask of the PCF8574 pin the signal is wired to. A 32-byte
+		 * lookup table is built once, so remapping costs one table load per expander byte;
+		 * the DFRobot layout needs no table at all.
+		 */
+		void setPinMap(uint8_t rs, uint8_t rw, uint8_t en, uint8_t backlight,
+			uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7);
+
+		/**
+		 * @brief Sets the expander wiring from a pin map struct like LCD::DFRobotPins.
+		 * @tparam PinMap  Struct with the static masks Rs, Rw, En, Backlight and D4-D7.
+		 */
+		template<class PinMap>
+		void setPinMap() {
+			setPinMap(PinMap::Rs, PinMap::Rw, PinMap::En, PinMap::Backlight,
+				PinMap::D4, PinMap::D5, PinMap::D6, PinMap::D7);
+		}
+
+		/**
+		 * @brief Enables non-blocking operation through a command queue.
+		 *
+		 * Allocates a ring buffer of commands. While enabled, every method (including begin())
+		 * only enqueues its transfers and returns immediately; the settle times become deadlines
+		 * that poll() waits out without blocking. A call that finds the queue full drains it
+		 * until there is room. Busy flag polling is not used in this mode.
+		 *
+		 * @param entries  Queue size; each entry takes 4 bytes of RAM.
+		 * @retval true  Queue is enabled.
+		 * @retval false Not enough memory.
+		 */
+		bool enableQueue(uint8_t entries = LCD_I2C_QUEUE);
+
+		/**
+		 * @brief Sends everything still queued, then returns to blocking operation.
+		 */
+		void disableQueue();
+
+		/**
+		 * @brief Advances the non-blocking transfer; call it from loop().
+		 *
+		 * Sends at most one I2C transaction (consecutive characters share one, as with
+		 * write(const uint8_t*, size_t)) once the previous settle time has passed.
+		 *
+		 * @retval true  Transfers or settle times are still pending.
+		 * @retval false The display is idle.
+		 */
+		bool poll();
+
+#if LCD_I2C_STATS
+		/**
+		 * @brief Returns the counters collected since construction or resetStats().
+		 *
+		 * Bus time is measured in blocking mode only; in non-blocking mode transfers
+		 * overlap with the caller and only the settle deadlines are known. Each write(),
+		 * and so each print() of a string, counts as one write call with or without the
+		 * framebuffer.
+		 */
+		const LCD::Stats& getStats();
+
+		/**
+		 * @brief Zeroes all counters.
+		 */
+		void resetStats();
+#endif
+
 	protected:
 		virtual void send(uint8_t, uint8_t);
 		virtual void write4bits(uint8_t);
 		virtual void expanderWrite(uint8_t);
 		virtual void pulseEnable(uint8_t);
+
+		void sendData(const uint8_t*, size_t, bool flash = false);
+
+		void beginFrame();
+		void pushNibble(uint8_t, bool);
+		void pushByte(uint8_t, uint8_t);
+		void pushPins(uint8_t);
+		bool endFrame();
 	
 	private:
-		uint8_t _addr;
+		struct QueueEntry {
+			uint8_t value;
+			uint8_t flags;
+			uint16_t wait;
+		};
+
+		void sendPadded(const char*, uint8_t);
+		void pushWide(uint8_t, uint8_t, bool);
+		size_t perFrame();
+		uint16_t settleTime(uint8_t);
+		size_t writeCell(uint8_t);
+		size_t writeCells(const uint8_t*, size_t);
+#if LCD_I2C_CHARSET
+		void transcode(const uint8_t*, size_t);
+#endif
+		void enqueue(uint8_t, uint8_t, uint16_t);
+		void settle(uint32_t);
+		void clearDisplay();
+		void trackAddress(uint8_t, uint8_t);
+		uint8_t nextAddress(uint8_t, bool);
+		uint8_t cacheGlyph(const uint8_t*, bool);
+		void uploadGlyph(uint8_t, const uint8_t*, bool);
+		void touchGlyph(uint8_t);
+		bool glyphShown(uint8_t);
+		void forgetGlyphs();
+		uint8_t pinout(uint8_t);
+		uint8_t datapins(uint8_t);
+		void displayControl(uint8_t);
+		void entryMode(uint8_t);
+		bool pollsWithin(uint16_t);
+		void waitReady(uint16_t);
+		uint8_t readStatus(bool);
+		void endStatus();
+		uint8_t address(uint8_t, uint8_t);
+
 		uint8_t _displayfunction;
 		uint8_t _displaycontrol;
 		uint8_t _displaymode;
@@ -251,5 +810,51 @@ class LiquidCrystal_I2C: public Print {
 		uint8_t _rows;
 		uint8_t _charsize;
 		uint8_t _backlightval;
+		uint16_t _expanderval; // last byte on the expander pins
+		uint8_t _framelen;     // bytes in the current transaction
+		bool _eightbit;        // 8-bit interface: data on one port, control pins on the other
+		uint8_t* _pinmap;      // wiring lookup table, nullptr for the DFRobot layout
+		uint8_t _ddram;        // the controller's DDRAM address, as far as it is known
+		const uint8_t* _glyphs[8]; // bitmap resident in each CGRAM slot, null after createChar()
+		uint8_t _glyphlru[8];  // CGRAM slots, most recently used first
+		uint8_t _glyphflash;   // slots whose bitmap is in PROGMEM
+		uint8_t _error;        // status of the last failed transaction
+		uint32_t _transactions;
+		bool _autorecover;
+		uint8_t _transmitmode;
+		uint16_t _bytemicros;  // time of one byte on the bus, 0 if the clock is unknown
+		bool _busyrequest;
+		bool _busypoll;
+		uint8_t* _front; // framebuffer: characters on the glass
+		uint8_t* _back;  // framebuffer: characters to be flushed
+		bool _stale;     // glass contents unknown, redraw everything on flush()
+		uint8_t _blankcells; // present(): blank the display for deltas this large
+		uint16_t _refreshms; // refresh(): minimum interval
+		unsigned long _refreshat; // millis() of the last refresh
+		uint8_t _col;    // framebuffer cursor
+		uint8_t _row;
+		QueueEntry* _queue;    // non-blocking mode: ring buffer
+		uint8_t _queuesize;
+		uint8_t _queuehead;
+		uint8_t _queuecount;
+		unsigned long _sentat; // non-blocking mode: settle deadline of the last transfer
+		uint32_t _wait;
 		TwoWire& _Wire;
+		LCD::WireTransport _wiretransport;
+		LCD::Transport* _transport;
+		bool _inflight;        // non-blocking mode: background transfer not yet done
+		const char* _marquee;  // text of a row marquee
+#if LCD_I2C_CHARSET
+		uint8_t _charset;
+		uint8_t _utf8left;     // continuation bytes still expected
+		uint32_t _codepoint;   // decoded so far
+#endif
+		uint8_t _marqueerow;   // scrolling row, or a MarqueeOff/MarqueeShift state
+		uint8_t _marqueelen;
+		uint8_t _marqueepos;
+		uint16_t _marqueeinterval;
+		unsigned long _marqueeat; // millis() of the last step
+#if LCD_I2C_STATS
+		LCD::Stats _stats;
+#endif
 };
@@ -0,0 +1,31 @@
+#include "LiquidCrystal_I2C_Bus.h"
+
+LiquidCrystal_I2C_Bus::LiquidCrystal_I2C_Bus():
+	_displays(),
+	_count(0),
+	_next(0)
+{}
+
+bool LiquidCrystal_I2C_Bus::add(LiquidCrystal_I2C& lcd) {
+	if (_count == LCD_I2C_BUS_DISPLAYS) {
+		return false;
+	}
+	_displays[_count++] = &lcd;
+	return true;
+}
+
+bool LiquidCrystal_I2C_Bus::poll() {
+	bool pending = false;
+	for (uint8_t i = 0; i < _count; i++) {
+		pending = _displays[(_next + i) % _count]->poll() || pending;
+	}
+	if (_count > 0) {
+		_next = (_next + 1) % _count;
+	}
+	return pending;
+}
+
+void LiquidCrystal_I2C_Bus::wait() {
+	while (poll()) {
+	}
+}
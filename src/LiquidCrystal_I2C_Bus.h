@@ -0,0 +1,51 @@
+#pragma once
+
+#include "LiquidCrystal_I2C.h"
+
+// Largest number of displays one LiquidCrystal_I2C_Bus schedules (PCF8574 addresses 0x20-0x27)
+#ifndef LCD_I2C_BUS_DISPLAYS
+	#define LCD_I2C_BUS_DISPLAYS 8
+#endif
+
+/*!
+ * @class LiquidCrystal_I2C_Bus
+ * @brief Interleaves the transfers of several displays sharing one I2C bus.
+ *
+ * Each display runs with its command queue enabled (LiquidCrystal_I2C::enableQueue()), so
+ * its calls only enqueue. poll() gives every display a turn; a display that is waiting out
+ * a settle time skips it, so the bus serves the others meanwhile, and begin(), clear() or
+ * flush() on all panels proceed in parallel instead of one after another.
+ */
+class LiquidCrystal_I2C_Bus {
+	public:
+		LiquidCrystal_I2C_Bus();
+
+		/**
+		 * @brief Adds a display to the schedule.
+		 *
+		 * @param lcd  Display to schedule; its queue should be enabled.
+		 * @retval true  Display added.
+		 * @retval false LCD_I2C_BUS_DISPLAYS displays are scheduled already.
+		 */
+		bool add(LiquidCrystal_I2C& lcd);
+
+		/**
+		 * @brief Gives each display the chance to send one transaction; call it from loop().
+		 *
+		 * The display served first rotates on every call, so no panel can starve the others.
+		 *
+		 * @retval true  Some display still has transfers or settle times pending.
+		 * @retval false All displays are idle.
+		 */
+		bool poll();
+
+		/**
+		 * @brief Polls until all displays are idle.
+		 */
+		void wait();
+
+	private:
+		LiquidCrystal_I2C* _displays[LCD_I2C_BUS_DISPLAYS];
+		uint8_t _count;
+		uint8_t _next;
+};
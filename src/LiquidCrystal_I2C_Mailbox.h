@@ -0,0 +1,132 @@
+#pragma once
+
+#include "LiquidCrystal_I2C.h"
+
+// Characters one mailbox slot carries, a 20 column row by default
+#ifndef LCD_I2C_MAILBOX_BYTES
+	#define LCD_I2C_MAILBOX_BYTES 20
+#endif
+
+/*!
+ * @class LiquidCrystal_I2C_Mailbox
+ * @brief Lock-free submission queue for drawing on one display from several tasks.
+ *
+ * Producers submit() text for a cell range from any task; they never wait for the bus and
+ * never see the display half-way through another producer's update. One display task calls
+ * drain(), which is the only code touching the LiquidCrystal_I2C (and so the bus).
+ *
+ * Each transaction on the bus is complete in itself, so the TwoWire instance can be shared
+ * with other devices as long as the core serializes transactions (the ESP32 core locks from
+ * beginTransmission() to endTransmission()).
+ *
+ * A bounded multi-producer ring with a sequence number per slot. Header only, since it needs
+ * the compiler's __atomic builtins for the word size (ESP32, ARM cores).
+ *
+ * @tparam Slots  Queue length, a power of two.
+ */
+template<uint8_t Slots = 16>
+class LiquidCrystal_I2C_Mailbox {
+	static_assert(Slots >= 2 && (Slots & (Slots - 1)) == 0, "Slots must be a power of two");
+
+	public:
+		/**
+		 * @param lcd  Display drawn by drain(); no other code should use it meanwhile.
+		 */
+		LiquidCrystal_I2C_Mailbox(LiquidCrystal_I2C& lcd):
+			_lcd(lcd),
+			_head(0),
+			_tail(0)
+		{
+			for (unsigned i = 0; i < Slots; i++) {
+				_slots[i].seq = i;
+			}
+		}
+
+		/**
+		 * @brief Queues characters for the cells starting at col/row; safe from any task.
+		 *
+		 * Longer text takes one slot per LCD_I2C_MAILBOX_BYTES characters.
+		 *
+		 * @retval true  Everything was queued.
+		 * @retval false The queue was full, the rest was dropped.
+		 */
+		bool submit(uint8_t col, uint8_t row, const uint8_t* data, uint8_t size) {
+			do {
+				uint8_t n = size < LCD_I2C_MAILBOX_BYTES ? size : LCD_I2C_MAILBOX_BYTES;
+				if (!push(col, row, data, n)) {
+					return false;
+				}
+				col += n;
+				data += n;
+				size -= n;
+			} while (size > 0);
+			return true;
+		}
+
+		bool submit(uint8_t col, uint8_t row, const char* text) {
+			size_t len = strlen(text);
+			return submit(col, row, (const uint8_t*)text, len < 255 ? len : 255);
+		}
+
+		/**
+		 * @brief Draws queued updates in submission order; call it from the display task only.
+		 * @param max  Most updates to draw in this call.
+		 * @return Number of updates drawn.
+		 */
+		uint8_t drain(uint8_t max = Slots) {
+			uint8_t count = 0;
+			while (count < max) {
+				Slot& slot = _slots[_head & (Slots - 1)];
+				unsigned seq = __atomic_load_n(&slot.seq, __ATOMIC_ACQUIRE);
+				if ((int)(seq - (_head + 1)) < 0) {
+					break;	// empty, or the producer of this slot is still copying
+				}
+				_lcd.setCursor(slot.col, slot.row);
+				_lcd.write(slot.data, slot.size);
+				__atomic_store_n(&slot.seq, _head + Slots, __ATOMIC_RELEASE);
+				_head++;
+				count++;
+			}
+			return count;
+		}
+
+	private:
+		struct Slot {
+			unsigned seq;	// index of the submission it holds (+1 once filled)
+			uint8_t col;
+			uint8_t row;
+			uint8_t size;
+			uint8_t data[LCD_I2C_MAILBOX_BYTES];
+		};
+
+		bool push(uint8_t col, uint8_t row, const uint8_t* data, uint8_t size) {
+			unsigned pos = __atomic_load_n(&_tail, __ATOMIC_RELAXED);
+			Slot* slot;
+			for (;;) {
+				slot = &_slots[pos & (Slots - 1)];
+				unsigned seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+				int diff = (int)(seq - pos);
+				if (diff == 0) {
+					// claim the slot; on failure pos is reloaded
+					if (__atomic_compare_exchange_n(&_tail, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+						break;
+					}
+				} else if (diff < 0) {
+					return false;	// full
+				} else {
+					pos = __atomic_load_n(&_tail, __ATOMIC_RELAXED);
+				}
+			}
+			slot->col = col;
+			slot->row = row;
+			slot->size = size;
+			memcpy(slot->data, data, size);
+			__atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+			return true;
+		}
+
+		LiquidCrystal_I2C& _lcd;
+		Slot _slots[Slots];
+		unsigned _head;	// consumer only
+		unsigned _tail;	// next submission, shared by the producers
+};
@@ -0,0 +1,147 @@
+#include "LiquidCrystal_I2C_Power.h"
+
+// First guess for a PCF8574 write at 100kHz: address, data byte, start and stop
+static constexpr uint16_t ToggleMicros = 300;
+static constexpr unsigned long Minute = 60000;
+
+LiquidCrystal_I2C_Power::LiquidCrystal_I2C_Power(LiquidCrystal_I2C& lcd):
+	_lcd(lcd),
+	_dimms(0),
+	_offms(0),
+	_activeat(millis()),
+	_state(LCD::Power::Active),
+	_level(0),
+	_busduty(10),
+	_displayoff(false),
+	_blanked(false),
+	_lit(true),
+	_edge(0),
+	_togglemicros(ToggleMicros),
+	_minuteat(millis()),
+	_minutecount(lcd.getTransactions()),
+	_perminute(0)
+{}
+
+void LiquidCrystal_I2C_Power::setTimeouts(uint32_t dimMillis, uint32_t offMillis) {
+	_dimms = dimMillis;
+	_offms = offMillis;
+}
+
+void LiquidCrystal_I2C_Power::setDimLevel(uint8_t level, uint8_t busDuty) {
+	_level = level;
+	_busduty = busDuty ? (busDuty < 100 ? busDuty : 100) : 1;
+	if (_state == LCD::Power::Dim) {
+		enter(LCD::Power::Dim);
+	}
+}
+
+void LiquidCrystal_I2C_Power::setDisplayOff(bool enable) {
+	_displayoff = enable;
+}
+
+void LiquidCrystal_I2C_Power::activity() {
+	_activeat = millis();
+	enter(LCD::Power::Active);
+}
+
+uint8_t LiquidCrystal_I2C_Power::getState() {
+	return _state;
+}
+
+uint16_t LiquidCrystal_I2C_Power::wakeupsPerMinute() {
+	return _perminute;
+}
+
+// backlight() and display() skip unchanged states, so entering the current
+// state again sends nothing
+void LiquidCrystal_I2C_Power::enter(uint8_t state) {
+	_state = state;
+	switch (state) {
+		case LCD::Power::Active:
+			if (_blanked) {
+				_lcd.display();	// only undo our own noDisplay(), not the application's
+				_blanked = false;
+			}
+			_lcd.backlight();
+			break;
+		case LCD::Power::Dim:
+			if (_level) {
+				_lcd.backlight();
+			} else {
+				_lcd.noBacklight();
+			}
+			_lit = true;
+			_edge = micros();
+			break;
+		default:
+			_lcd.noBacklight();
+			if (_displayoff && _lcd.getDisplay()) {
+				_lcd.noDisplay();
+				_blanked = true;
+			}
+	}
+}
+
+uint32_t LiquidCrystal_I2C_Power::update() {
+	unsigned long now = millis();
+	if (now - _minuteat >= Minute) {
+		// a long sleep spreads its wakeups over the minutes it lasted
+		uint32_t count = _lcd.getTransactions();
+		uint32_t rate = (uint64_t)(count - _minutecount) * Minute / (now - _minuteat);
+		_perminute = rate < 0xffff ? rate : 0xffff;
+		_minutecount = count;
+		_minuteat = now;
+	}
+
+	unsigned long idle = now - _activeat;
+	if (_state == LCD::Power::Active && _dimms && idle >= _dimms && (!_offms || _dimms < _offms)) {
+		enter(LCD::Power::Dim);
+	}
+	if (_state != LCD::Power::Off && _offms && idle >= _offms) {
+		enter(LCD::Power::Off);
+	}
+
+	switch (_state) {
+		case LCD::Power::Active:
+			if (_dimms && (!_offms || _dimms < _offms)) {
+				return _dimms - idle;
+			}
+			return _offms ? _offms - idle : 0xffffffff;
+		case LCD::Power::Dim:
+			if (pwm()) {
+				return 0;
+			}
+			return _offms ? _offms - idle : 0xffffffff;
+		default:
+			return 0xffffffff;
+	}
+}
+
+// Toggles the backlight bit when the current phase is over; returns whether PWM runs
+bool LiquidCrystal_I2C_Power::pwm() {
+	if (_level == 0 || _level == 255) {
+		return false;
+	}
+	// two toggles per period take at most _busduty percent of it
+	uint32_t period = (uint32_t)_togglemicros * 200 / _busduty;
+	uint32_t on = period * _level / 255;
+	if (on < _togglemicros) {
+		on = _togglemicros;
+	} else if (on > period - _togglemicros) {
+		on = period - _togglemicros;
+	}
+	unsigned long now = micros();
+	if (now - _edge < (_lit ? on : period - on)) {
+		return true;
+	}
+	_lit = !_lit;
+	_edge = now;
+	if (_lit) {
+		_lcd.backlight();
+	} else {
+		_lcd.noBacklight();
+	}
+	uint32_t took = micros() - now;
+	_togglemicros = (3 * (uint32_t)_togglemicros + (took ? took : 1)) / 4;
+	return true;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "LiquidCrystal_I2C.h"
+
+namespace LCD {
+
+	namespace Power {
+		static constexpr uint8_t Active = 0;  // full backlight
+		static constexpr uint8_t Dim = 1;     // dim level, after the dim timeout
+		static constexpr uint8_t Off = 2;     // backlight (and optionally display) off
+	}
+
+} // namespace LCD
+
+/*!
+ * @class LiquidCrystal_I2C_Power
+ * @brief Idle timeouts and backlight dimming for battery powered displays.
+ *
+ * After the dim timeout without activity() the backlight drops to the dim level, after
+ * the off timeout it goes out. Each step costs a single transaction; apart from them and
+ * the dim phase, update() never touches the bus, and it returns how long the MCU may sleep.
+ *
+ * The dim level is software PWM on the backlight bit, two transactions per period. The
+ * period is stretched so that they take at most the given share of the bus time; update()
+ * has to run continuously meanwhile, so keep the dim phase short or use level 0 on battery.
+ */
+class LiquidCrystal_I2C_Power {
+	public:
+		/**
+		 * @param lcd  Display whose backlight() and display() are managed.
+		 */
+		LiquidCrystal_I2C_Power(LiquidCrystal_I2C& lcd);
+
+		/**
+		 * @brief Sets the idle times, both counted from the last activity().
+		 * @param dimMillis  Time until the backlight dims, 0 to skip the dim phase.
+		 * @param offMillis  Time until the backlight goes off, 0 to never switch it off.
+		 */
+		void setTimeouts(uint32_t dimMillis, uint32_t offMillis);
+
+		/**
+		 * @brief Sets the backlight level of the dim phase.
+		 * @param level    On-time out of 255; 0 switches the backlight off, 255 keeps it on.
+		 * @param busDuty  Largest share of the bus time for the PWM, in percent (default 10).
+		 */
+		void setDimLevel(uint8_t level, uint8_t busDuty = 10);
+
+		/**
+		 * @brief Also blanks the display with noDisplay() when the backlight goes off.
+		 */
+		void setDisplayOff(bool enable);
+
+		/**
+		 * @brief Reports user activity: full backlight again and the timeouts restart.
+		 */
+		void activity();
+
+		/**
+		 * @brief Runs the timeouts and the PWM; call it from loop().
+		 * @return Milliseconds until update() has work again, 0 while dimming by PWM and
+		 *         0xffffffff when off until the next activity().
+		 */
+		uint32_t update();
+
+		/**
+		 * @brief Returns LCD::Power::Active, Dim or Off.
+		 */
+		uint8_t getState();
+
+		/**
+		 * @brief Returns the display's transactions per minute, averaged over the last full minute.
+		 */
+		uint16_t wakeupsPerMinute();
+
+	private:
+		void enter(uint8_t);
+		bool pwm();
+
+		LiquidCrystal_I2C& _lcd;
+		uint32_t _dimms;
+		uint32_t _offms;
+		unsigned long _activeat;  // millis() of the last activity()
+		uint8_t _state;
+		uint8_t _level;
+		uint8_t _busduty;
+		bool _displayoff;
+		bool _blanked;            // noDisplay() came from here
+		bool _lit;                // PWM phase
+		unsigned long _edge;      // micros() of the last PWM toggle
+		uint16_t _togglemicros;   // measured cost of one toggle
+		unsigned long _minuteat;
+		uint32_t _minutecount;    // getTransactions() at _minuteat
+		uint16_t _perminute;
+};
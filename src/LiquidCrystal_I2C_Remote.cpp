@@ -0,0 +1,148 @@
+#include "LiquidCrystal_I2C_Remote.h"
+
+// Parser states
+static constexpr uint8_t WaitSync = 0;
+static constexpr uint8_t WaitType = 1;
+static constexpr uint8_t WaitLength = 2;
+static constexpr uint8_t WaitPayload = 3;
+static constexpr uint8_t WaitCheck = 4;
+
+LiquidCrystal_I2C_Remote::LiquidCrystal_I2C_Remote(LiquidCrystal_I2C& lcd):
+	_lcd(lcd),
+	_state(WaitSync),
+	_type(0),
+	_length(0),
+	_received(0),
+	_check(0),
+	_payload(),
+	_frames(0),
+	_errors(0)
+{}
+
+bool LiquidCrystal_I2C_Remote::feed(uint8_t value) {
+	switch (_state) {
+		case WaitSync:
+			if (value == LCD::Remote::Sync) {
+				_state = WaitType;
+			}
+			return false;
+		case WaitType:
+			_type = value;
+			_check = value;
+			_state = WaitLength;
+			return false;
+		case WaitLength:
+			if (value > LCD_I2C_REMOTE_PAYLOAD) {
+				_errors++;
+				_state = WaitSync;
+				return false;
+			}
+			_length = value;
+			_received = 0;
+			_check ^= value;
+			_state = value ? WaitPayload : WaitCheck;
+			return false;
+		case WaitPayload:
+			_payload[_received++] = value;
+			_check ^= value;
+			if (_received == _length) {
+				_state = WaitCheck;
+			}
+			return false;
+		default:
+			_state = WaitSync;
+			if (value != _check || !apply()) {
+				_errors++;
+				return false;
+			}
+			_frames++;
+			return true;
+	}
+}
+
+uint8_t LiquidCrystal_I2C_Remote::poll(Stream& in) {
+	uint8_t applied = 0;
+	while (in.available() > 0) {
+		applied += feed(in.read());
+	}
+	return applied;
+}
+
+bool LiquidCrystal_I2C_Remote::apply() {
+	switch (_type) {
+		case LCD::Remote::Cells:
+			return cells();
+		case LCD::Remote::Glyph:
+			if (_length != 9) {
+				return false;
+			}
+			_lcd.createChar(_payload[0], _payload + 1);
+			return true;
+		case LCD::Remote::Flush:
+			_lcd.flush();
+			return true;
+		case LCD::Remote::Backlight:
+			if (_length != 1) {
+				return false;
+			}
+			if (_payload[0]) {
+				_lcd.backlight();
+			} else {
+				_lcd.noBacklight();
+			}
+			return true;
+		default:
+			return false;
+	}
+}
+
+// Checks the whole payload first, so a malformed frame changes nothing
+bool LiquidCrystal_I2C_Remote::cells() {
+	uint16_t total = (uint16_t)_lcd.getCols() * _lcd.getRows();
+	for (int pass = 0; pass < 2; pass++) {
+		uint16_t cell = 0;
+		uint8_t i = 0;
+		while (i < _length) {
+			if (_length - i < 2) {
+				return false;
+			}
+			cell += _payload[i];
+			uint8_t op = _payload[i + 1];
+			uint8_t count = op & ~LCD::Remote::Run;
+			bool run = op & LCD::Remote::Run;
+			i += 2;
+			if (_length - i < (run ? 1 : count) || cell + count > total) {
+				return false;
+			}
+			if (pass) {
+				put(cell, _payload + i, count, run);
+			}
+			cell += count;
+			i += run ? 1 : count;
+		}
+	}
+	return true;
+}
+
+// One setCursor() and bulk write() per row the cells touch
+void LiquidCrystal_I2C_Remote::put(uint8_t cell, const uint8_t* data, uint8_t count, bool run) {
+	uint8_t cols = _lcd.getCols();
+	uint8_t fill[20];
+	if (run) {
+		memset(fill, *data, sizeof(fill));
+	}
+	while (count > 0) {
+		uint8_t col = cell % cols;
+		uint8_t n = cols - col < count ? cols - col : count;
+		if (run && n > sizeof(fill)) {
+			n = sizeof(fill);
+		}
+		_lcd.setCursor(col, cell / cols);
+		_lcd.write(run ? fill : data, n);
+		if (!run) {
+			data += n;
+		}
+		cell += n;
+		count -= n;
+	}
+}
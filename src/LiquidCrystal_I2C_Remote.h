@@ -0,0 +1,73 @@
+#pragma once
+
+#include "LiquidCrystal_I2C.h"
+
+// Largest frame payload LiquidCrystal_I2C_Remote accepts, a delta frame of a 20x4 screen by default
+#ifndef LCD_I2C_REMOTE_PAYLOAD
+	#define LCD_I2C_REMOTE_PAYLOAD 88
+#endif
+
+namespace LCD {
+
+	namespace Remote {
+		static constexpr uint8_t Sync = 0xa5;        // starts every frame
+		static constexpr uint8_t Cells = 0x01;       // delta-encoded cell updates
+		static constexpr uint8_t Glyph = 0x02;       // slot, 8 bitmap rows
+		static constexpr uint8_t Flush = 0x03;       // send the framebuffer delta
+		static constexpr uint8_t Backlight = 0x04;   // 0 off, else on
+		static constexpr uint8_t Run = 0x80;         // Cells op flag: next byte repeated
+	}
+
+} // namespace LCD
+
+/*!
+ * @class LiquidCrystal_I2C_Remote
+ * @brief Renders screen updates sent by a host in compact binary frames, e.g. over Serial.
+ *
+ * A frame is Sync, type, payload length, payload, and the XOR of type, length and payload.
+ * A Cells payload is a series of skip, op, data groups over the cells in row-major order,
+ * starting at cell 0: skip cells are left alone, then op & 0x7f cells follow, either as
+ * that many bytes or, with LCD::Remote::Run set, as one byte repeated.
+ *
+ * Cells go through setCursor() and one bulk write() per row, so with the framebuffer
+ * enabled they only touch memory until the host sends Flush. Frames with a bad checksum
+ * or length are dropped and the parser hunts for the next Sync.
+ */
+class LiquidCrystal_I2C_Remote {
+	public:
+		/**
+		 * @param lcd  Display the frames are drawn on.
+		 */
+		LiquidCrystal_I2C_Remote(LiquidCrystal_I2C& lcd);
+
+		/**
+		 * @brief Parses one received byte.
+		 * @retval true  The byte completed a valid frame, which was applied.
+		 * @retval false More bytes are needed, or the frame was dropped.
+		 */
+		bool feed(uint8_t);
+
+		/**
+		 * @brief Feeds every byte the stream has available; call it from loop().
+		 * @return Number of frames applied.
+		 */
+		uint8_t poll(Stream& in);
+
+		uint16_t frames() { return _frames; }  // frames applied
+		uint16_t errors() { return _errors; }  // frames dropped
+
+	private:
+		bool apply();
+		bool cells();
+		void put(uint8_t, const uint8_t*, uint8_t, bool);
+
+		LiquidCrystal_I2C& _lcd;
+		uint8_t _state;
+		uint8_t _type;
+		uint8_t _length;
+		uint8_t _received;
+		uint8_t _check;
+		uint8_t _payload[LCD_I2C_REMOTE_PAYLOAD];
+		uint16_t _frames;
+		uint16_t _errors;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <SPI.h>
+#include "LiquidCrystal_I2C.h"
+
+namespace LCD {
+
+	/*!
+	 * @class SPITransport
+	 * @brief A 74HC595 shift register backpack on SPI, wired like the PCF8574 (or use setPinMap()).
+	 *
+	 * Every expander byte is shifted out and latched with a rising edge on the latch (RCLK) pin.
+	 * Shift registers cannot be read, so busy flag polling is not available.
+	 *
+	 * Header only, so SPI is only linked into sketches that include this file.
+	 */
+	class SPITransport: public Transport {
+		public:
+			/**
+			 * @param latch  Pin connected to the 74HC595 latch clock (RCLK).
+			 * @param spi    SPI bus to use (default: SPI).
+			 * @param clock  SPI clock in Hz.
+			 */
+			SPITransport(uint8_t latch, SPIClass& spi = SPI, uint32_t clock = 8000000):
+				_latch(latch),
+				_clock(clock),
+				_spi(spi)
+			{}
+
+			/**
+			 * @brief Sets up the latch pin and the SPI bus; call before LiquidCrystal_I2C::begin().
+			 */
+			void begin() {
+				pinMode(_latch, OUTPUT);
+				digitalWrite(_latch, HIGH);
+				_spi.begin();
+			}
+
+			using Transport::write;
+
+			virtual void beginWrite() {
+				_spi.beginTransaction(SPISettings(_clock, MSBFIRST, SPI_MODE0));
+			}
+
+			virtual void write(uint8_t data) {
+				digitalWrite(_latch, LOW);
+				_spi.transfer(data);
+				digitalWrite(_latch, HIGH);	// outputs follow on the rising edge
+			}
+
+			virtual uint8_t endWrite() {
+				_spi.endTransaction();
+				return 0;
+			}
+
+			// The bytes of a frame follow each other in about a microsecond, too fast to
+			// stand in for the controller's 37us execution time the way I2C bytes do, so
+			// each frame carries one command or character and the driver's settle delay
+			// separates them.
+			virtual size_t capacity() { return 6; }
+
+		private:
+			uint8_t _latch;
+			uint32_t _clock;
+			SPIClass& _spi;
+	};
+
+} // namespace LCD
@@ -0,0 +1,213 @@
+#include "LiquidCrystal_I2C_Sim.h"
+
+namespace LCD {
+
+	// DFRobot layout of the control pins
+	static constexpr uint8_t Rs = 0x01;
+	static constexpr uint8_t Rw = 0x02;
+	static constexpr uint8_t En = 0x04;
+
+	// execution times from the datasheet, at 270kHz
+	static constexpr uint16_t ExecMicros = 37;
+	static constexpr uint16_t HomeMicros = 1520;
+
+	static bool before(unsigned long a, unsigned long b) {
+		return (long)(a - b) < 0;
+	}
+
+	SimTransport::SimTransport(uint32_t clock, uint8_t databits):
+		_databits(databits),
+		_bytetime((9000000UL + clock - 1) / clock),	// 8 data bits and the ack
+		_at(0),
+		_busfree(0),
+		_trace(nullptr),
+		_context(nullptr)
+	{
+		reset();
+		resetCounters();
+	}
+
+	void SimTransport::reset() {
+		memset(_ddram, ' ', sizeof(_ddram));
+		memset(_cgram, 0, sizeof(_cgram));
+		_ac = 0;
+		_cg = false;
+		_nibbles = false;	// the controller wakes up in 8-bit mode
+		_second = false;
+		_readsecond = false;
+		_high = 0;
+		_function = 0x10;
+		_mode = 0x02;
+		_display = 0;
+		_data = 0xff;
+		_control = 0xff;
+		_port = false;
+		_busyuntil = 0;
+	}
+
+	void SimTransport::resetCounters() {
+		_transactions = 0;
+		_bytes = 0;
+		_instructions = 0;
+		_violations = 0;
+	}
+
+	void SimTransport::setTrace(void (*trace)(void*, uint8_t, unsigned long), void* context) {
+		_trace = trace;
+		_context = context;
+	}
+
+	void SimTransport::beginWrite() {
+		unsigned long now = micros();
+		_at = (before(now, _busfree) ? _busfree : now) + _bytetime;	// address byte
+		_port = false;
+		_transactions++;
+	}
+
+	void SimTransport::write(uint8_t value) {
+		_at += _bytetime;
+		_bytes++;
+		if (_trace) {
+			_trace(_context, value, _at);
+		}
+		pins(value, _at);
+	}
+
+	uint8_t SimTransport::endWrite() {
+		_busfree = _at + 1;	// stop condition
+		return 0;
+	}
+
+	bool SimTransport::busy() {
+		return before(micros(), _busfree);
+	}
+
+	// with Rw and En high the controller drives D4-D7, one nibble of the status per pulse
+	bool SimTransport::read(uint8_t& value) {
+		if (_databits == 8) {
+			return false;
+		}
+		unsigned long now = micros();
+		_at = (before(now, _busfree) ? _busfree : now) + 2 * _bytetime;
+		_busfree = _at + 1;
+		_transactions++;
+		value = _data | _control;
+		if ((_control & Rw) && (_control & En)) {
+			uint8_t status = (before(_at, _busyuntil) ? 0x80 : 0) | _ac;
+			value = (_readsecond ? (uint8_t)(status << 4) : (status & 0xf0)) | _control;
+		}
+		return true;
+	}
+
+	uint8_t SimTransport::ddram(uint8_t addr) {
+		return _ddram[index(addr)];
+	}
+
+	uint8_t SimTransport::cgram(uint8_t addr) {
+		return _cgram[addr & 0x3f];
+	}
+
+	bool SimTransport::matches(const SimTransport& other) const {
+		return memcmp(_ddram, other._ddram, sizeof(_ddram)) == 0 && memcmp(_cgram, other._cgram, sizeof(_cgram)) == 0;
+	}
+
+	// one expander write; the controller latches on the falling edge of En
+	void SimTransport::pins(uint8_t value, unsigned long at) {
+		uint8_t data = _data;
+		uint8_t control = value & 0x0f;
+		if (_databits == 8) {
+			_port = !_port;
+			if (_port) {
+				_data = value;	// port A
+				return;
+			}
+		} else {
+			_data = value & 0xf0;
+		}
+		bool fall = (_control & En) && !(control & En);
+		if (fall && (_control & Rw)) {
+			_readsecond = _nibbles && !_readsecond;
+		} else if (fall) {
+			latch(data, _control & Rs, at);
+		}
+		_control = control;
+	}
+
+	// no write may arrive while busy, not even the first nibble
+	void SimTransport::latch(uint8_t value, bool rs, unsigned long at) {
+		if (before(at, _busyuntil)) {
+			_violations++;
+		}
+		if (!_nibbles) {
+			execute(value, rs, at);
+		} else if (!_second) {
+			_high = value & 0xf0;
+			_second = true;
+		} else {
+			_second = false;
+			execute(_high | (value >> 4), rs, at);
+		}
+	}
+
+	void SimTransport::execute(uint8_t value, bool rs, unsigned long at) {
+		_instructions++;
+		_busyuntil = at + ExecMicros;
+		if (rs) {
+			if (_cg) {
+				_cgram[_ac & 0x3f] = value;
+				_ac = (_mode & 0x02 ? _ac + 1 : _ac - 1) & 0x3f;
+			} else {
+				_ddram[index(_ac)] = value;
+				_ac = next(_ac, _mode & 0x02);
+			}
+		} else if (value & 0x80) {
+			_cg = false;
+			_ac = value & 0x7f;
+		} else if (value & 0x40) {
+			_cg = true;
+			_ac = value & 0x3f;
+		} else if (value & 0x20) {
+			_function = value;
+			_nibbles = !(value & 0x10);
+			_second = false;
+			_readsecond = false;
+		} else if (value & 0x10) {
+			if (!(value & 0x08)) {
+				_ac = next(_ac, value & 0x04);	// cursor move, the display shift keeps DDRAM
+			}
+		} else if (value & 0x08) {
+			_display = value & 0x07;	// contents are unaffected
+		} else if (value & 0x04) {
+			_mode = value & 0x03;
+		} else if (value & 0x02) {
+			_ac = 0;
+			_cg = false;
+			_busyuntil = at + HomeMicros;
+		} else if (value & 0x01) {
+			memset(_ddram, ' ', sizeof(_ddram));
+			_ac = 0;
+			_cg = false;
+			_mode |= 0x02;
+			_busyuntil = at + HomeMicros;
+		}
+	}
+
+	// DDRAM is 0x00-0x4f in 1-line mode, 0x00-0x27 and 0x40-0x67 in 2-line mode
+	uint8_t SimTransport::index(uint8_t addr) {
+		if (!(_function & 0x08)) {
+			return addr % 80;
+		}
+		return (addr & 0x40 ? 40 : 0) + (addr & 0x3f) % 40;
+	}
+
+	uint8_t SimTransport::next(uint8_t addr, uint8_t forward) {
+		if (!(_function & 0x08)) {
+			return forward ? (addr >= 0x4f ? 0x00 : addr + 1) : (addr == 0x00 ? 0x4f : addr - 1);
+		}
+		if (forward) {
+			return addr == 0x27 ? 0x40 : (addr == 0x67 ? 0x00 : addr + 1);
+		}
+		return addr == 0x40 ? 0x27 : (addr == 0x00 ? 0x67 : addr - 1);
+	}
+
+} // namespace LCD
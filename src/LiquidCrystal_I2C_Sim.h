@@ -0,0 +1,108 @@
+#pragma once
+
+#include "LiquidCrystal_I2C_Transport.h"
+
+namespace LCD {
+
+	/*!
+	 * @class SimTransport
+	 * @brief A transport without hardware: an HD44780 model decodes the expander bytes.
+	 *
+	 * Bytes are timed as on an I2C bus of the given clock, so busy() holds the driver for
+	 * as long as a real transaction would, and every instruction latched while the model
+	 * is still executing the previous one is counted as a violation. The model follows the
+	 * DFRobot layout (or, with 8 data bits, the MCP23017Transport port pairs without the
+	 * register byte) and answers busy flag reads.
+	 *
+	 * Use it to count the bus cost of an API call, or to check that two ways of drawing
+	 * leave the same contents behind with matches().
+	 *
+	 * Time is micros(): the real clock on a board, a fake one in the host build under
+	 * extras/test, where runs are deterministic.
+	 */
+	class SimTransport: public Transport {
+		public:
+			/**
+			 * @param clock     Simulated I2C clock in Hz.
+			 * @param databits  4 for a PCF8574, 8 for an MCP23017.
+			 */
+			SimTransport(uint32_t clock = 100000, uint8_t databits = 4);
+
+			/**
+			 * @brief Powers the model up again: random contents are shown as spaces, counters are kept.
+			 */
+			void reset();
+
+			using Transport::write;
+			virtual void beginWrite();
+			virtual void write(uint8_t);
+			virtual uint8_t endWrite();
+			virtual bool busy();
+			virtual size_t capacity() { return _databits == 8 ? LCD_I2C_TX_BUFFER - 1 : LCD_I2C_TX_BUFFER; }
+			virtual bool read(uint8_t&);
+			virtual uint8_t dataBits() { return _databits; }
+
+			/**
+			 * @brief Calls trace(context, value, at) for every expander byte, at its simulated time in us.
+			 */
+			void setTrace(void (*trace)(void*, uint8_t, unsigned long), void* context);
+
+			/**
+			 * @brief Returns the character code at a DDRAM address (0x00-0x27 and 0x40-0x67 on two lines).
+			 */
+			uint8_t ddram(uint8_t addr);
+
+			/**
+			 * @brief Returns one CGRAM byte, 8 per custom character.
+			 */
+			uint8_t cgram(uint8_t addr);
+
+			/**
+			 * @brief Returns whether both models show the same characters and glyphs.
+			 */
+			bool matches(const SimTransport& other) const;
+
+			uint32_t transactions() { return _transactions; }
+			uint32_t bytes() { return _bytes; }
+			uint32_t instructions() { return _instructions; }  // commands and characters executed
+			uint32_t violations() { return _violations; }      // latched while busy
+			uint8_t displayControl() { return _display; }      // last DisplayControl bits, 0 after power-on
+
+			void resetCounters();
+
+		private:
+			void pins(uint8_t, unsigned long);
+			void latch(uint8_t, bool, unsigned long);
+			void execute(uint8_t, bool, unsigned long);
+			uint8_t index(uint8_t);
+			uint8_t next(uint8_t, uint8_t);
+
+			uint8_t _databits;
+			uint8_t _bytetime;      // us per byte on the wire, with its ack
+			unsigned long _at;      // simulated time of the current byte
+			unsigned long _busfree; // end of the last transaction
+			unsigned long _busyuntil;
+			void (*_trace)(void*, uint8_t, unsigned long);
+			void* _context;
+
+			uint8_t _ddram[80];
+			uint8_t _cgram[64];
+			uint8_t _ac;            // address counter
+			bool _cg;               // the address counter points into CGRAM
+			bool _nibbles;          // 4-bit interface
+			bool _second;           // 4-bit: the high nibble is in
+			bool _readsecond;       // 4-bit: the next read is the low nibble
+			uint8_t _high;
+			uint8_t _function;
+			uint8_t _mode;
+			uint8_t _display;
+			uint8_t _data;          // levels on D0-D7
+			uint8_t _control;       // levels on Rs, Rw, En, backlight
+			bool _port;             // 8-bit: the next byte sets the control port
+			uint32_t _transactions;
+			uint32_t _bytes;
+			uint32_t _instructions;
+			uint32_t _violations;
+	};
+
+} // namespace LCD
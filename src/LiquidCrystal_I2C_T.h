@@ -0,0 +1,236 @@
+#pragma once
+
+#include "LiquidCrystal_I2C.h"
+
+/*!
+ * @class LiquidCrystal_I2C_T
+ * @brief Compile-time specialized driver for a fixed display geometry and expander wiring.
+ *
+ * Offers the core API of LiquidCrystal_I2C (without framebuffer, queue or busy polling), but
+ * the geometry, the DDRAM row offsets and the nibble packing are constants and nothing
+ * below Print::write() is virtual, so the whole path from print() to the Wire buffer inlines.
+ *
+ * @tparam Cols    Number of columns (characters per line), up to 40.
+ * @tparam Rows    Number of rows (lines), 1 to 4.
+ * @tparam PinMap  Expander wiring, a struct like LCD::DFRobotPins.
+ */
+template<uint8_t Cols, uint8_t Rows, class PinMap = LCD::DFRobotPins>
+class LiquidCrystal_I2C_T: public Print {
+	static_assert(Rows >= 1 && Rows <= 4, "HD44780 drives 1 to 4 rows");
+	static_assert(Cols >= 1 && Cols <= 40, "HD44780 rows hold at most 40 characters");
+
+	public:
+		/**
+		 * @brief Constructor for LiquidCrystal_I2C_T.
+		 *
+		 * @param lcd_addr   I2C slave address of the LCD display.
+		 * @param charsize   Character dot size; use LCD::Function::Font5x10 or LCD::Function::Font5x8.
+		 * @param wire       (Optional) Reference to the I2C bus to use (default: Wire).
+		 */
+		explicit LiquidCrystal_I2C_T(uint8_t lcd_addr, uint8_t charsize = LCD::Function::Font5x8, TwoWire& wire = Wire):
+			_addr(lcd_addr),
+			_displayfunction(LCD::Function::Bit4 | (Rows > 1 ? LCD::Function::Lines2 : LCD::Function::Lines1) |
+				((charsize != 0 && Rows == 1) ? LCD::Function::Font5x10 : LCD::Function::Font5x8)),
+			_displaycontrol(LCD::Control::On | LCD::Control::CursorOff | LCD::Control::BlinkOff),
+			_displaymode(LCD::Mode::Left | LCD::Mode::ShiftDecr),
+			_backlightval(0),
+			_Wire(wire)
+		{}
+
+		/**
+		 * @brief Initializes the LCD display; see LiquidCrystal_I2C::begin().
+		 * @param start  LCD::Start::Cold, LCD::Start::Fast or LCD::Start::Warm.
+		 */
+		void begin(uint8_t start = LCD::Start::Cold) {
+			bool warm = (start == LCD::Start::Warm);
+			if (start == LCD::Start::Cold) {
+				delay(50);
+				expanderWrite(0);
+				delay(1000);
+			} else {
+				if (!warm) {
+					delay(41);
+				}
+				expanderWrite(0);
+			}
+			// same reset sequence and timings as LiquidCrystal_I2C::begin()
+			write4bits(0x03);
+			delayMicroseconds(start == LCD::Start::Cold ? 4500 : (warm ? 1600 : 4200));
+			write4bits(0x03);
+			delayMicroseconds(start == LCD::Start::Cold ? 4500 : (warm ? 0 : 150));
+			write4bits(0x03);
+			delayMicroseconds(warm ? 0 : 150);
+			write4bits(0x02);
+
+			command(LCD::Command::FunctionSet | _displayfunction);
+			command(LCD::Command::DisplayControl | _displaycontrol);
+			if (!warm) {
+				clear();
+			}
+			command(LCD::Command::EntryModeSet | _displaymode);
+			if (!warm) {
+				home();
+			}
+		}
+
+		/** @brief Clears the display and returns the cursor to (0,0). */
+		void clear() {
+			command(LCD::Command::ClearDisplay);
+			delayMicroseconds(2000);  // this command takes a long time!
+		}
+
+		/** @brief Moves the cursor to (0,0). */
+		void home() {
+			command(LCD::Command::ReturnHome);
+			delayMicroseconds(2000);  // this command takes a long time!
+		}
+
+		/**
+		 * @brief Sets the cursor to the specified position.
+		 * @param col  Column position (0-based).
+		 * @param row  Row position (0-based), clamped to Rows - 1.
+		 */
+		void setCursor(uint8_t col, uint8_t row) {
+			command(LCD::Command::SetDDRAMAddr | (col + rowOffset(row < Rows ? row : Rows - 1)));
+		}
+
+		void noDisplay() { displayControl(_displaycontrol & ~LCD::Control::On); }
+		void display()   { displayControl(_displaycontrol | LCD::Control::On); }
+		void noBlink()   { displayControl(_displaycontrol & ~LCD::Control::BlinkOn); }
+		void blink()     { displayControl(_displaycontrol | LCD::Control::BlinkOn); }
+		void noCursor()  { displayControl(_displaycontrol & ~LCD::Control::CursorOn); }
+		void cursor()    { displayControl(_displaycontrol | LCD::Control::CursorOn); }
+
+		void scrollDisplayLeft()  { command(LCD::Command::CursorShift | LCD::Shift::DisplayMove | LCD::Shift::MoveLeft); }
+		void scrollDisplayRight() { command(LCD::Command::CursorShift | LCD::Shift::DisplayMove | LCD::Shift::MoveRight); }
+
+		void leftToRight()  { entryMode(_displaymode | LCD::Mode::Left); }
+		void rightToLeft()  { entryMode(_displaymode & ~LCD::Mode::Left); }
+		void autoscroll()   { entryMode(_displaymode | LCD::Mode::ShiftIncr); }
+		void noAutoscroll() { entryMode(_displaymode & ~LCD::Mode::ShiftIncr); }
+
+		void noBacklight() { _backlightval = 0; expanderWrite(0); }
+		void backlight()   { _backlightval = PinMap::Backlight; expanderWrite(0); }
+		bool getBacklight() { return _backlightval != 0; }
+
+		/**
+		 * @brief Creates a custom character in one of the 8 CGRAM locations.
+		 * @param location  Memory location (0~7).
+		 * @param charmap   8 bytes defining the 5x8 dot pattern.
+		 */
+		void createChar(uint8_t location, const uint8_t charmap[]) {
+			command(LCD::Command::SetCGRAMAddr | ((location & 0x7) << 3));
+			sendData(charmap, 8);
+		}
+
+		virtual size_t write(uint8_t value) {
+			send(value, PinMap::Rs);
+			return 1;
+		}
+
+		virtual size_t write(const uint8_t* buffer, size_t size) {
+			sendData(buffer, size);
+			return size;
+		}
+		using Print::write;
+
+		void command(uint8_t value) {
+			send(value, 0);
+		}
+
+	private:
+		// DDRAM address of the first cell of a row; rows 2 and 3 continue rows 0 and 1
+		static constexpr uint8_t rowOffset(uint8_t row) {
+			return (row & 1 ? 0x40 : 0x00) + (row & 2 ? Cols : 0);
+		}
+
+		// D4-D7 onto the expander pins
+		static constexpr uint8_t pack(uint8_t nibble) {
+			return ((nibble & 0x1) ? PinMap::D4 : 0) | ((nibble & 0x2) ? PinMap::D5 : 0) |
+				((nibble & 0x4) ? PinMap::D6 : 0) | ((nibble & 0x8) ? PinMap::D7 : 0);
+		}
+
+		static constexpr bool inOrder = PinMap::D4 == 0x10 && PinMap::D5 == 0x20 &&
+			PinMap::D6 == 0x40 && PinMap::D7 == 0x80;
+
+		// in-order wiring is a shift, anything else a single flash load
+		static const uint8_t _nibbles[16];
+
+		static uint8_t nibbleOut(uint8_t nibble) {
+			return inOrder ? (nibble << 4) : pgm_read_byte(&_nibbles[nibble]);
+		}
+
+		void displayControl(uint8_t control) {
+			if (control != _displaycontrol) {
+				_displaycontrol = control;
+				command(LCD::Command::DisplayControl | _displaycontrol);
+			}
+		}
+
+		void entryMode(uint8_t mode) {
+			if (mode != _displaymode) {
+				_displaymode = mode;
+				command(LCD::Command::EntryModeSet | _displaymode);
+			}
+		}
+
+		void pushNibble(uint8_t nibble, uint8_t mode) {
+			uint8_t out = nibbleOut(nibble) | mode | _backlightval;
+			_Wire.write(out);
+			_Wire.write(out | PinMap::En);
+			_Wire.write(out);
+		}
+
+		void pushByte(uint8_t value, uint8_t mode) {
+			pushNibble(value >> 4, mode);
+			pushNibble(value & 0x0f, mode);
+		}
+
+		void send(uint8_t value, uint8_t mode) {
+			_Wire.beginTransmission(_addr);
+			pushByte(value, mode);
+			_Wire.endTransmission();
+			delayMicroseconds(50);	// commands need > 37us to settle
+		}
+
+		// see LiquidCrystal_I2C::sendData() for the timing within a frame
+		void sendData(const uint8_t* buffer, size_t size) {
+			constexpr size_t perFrame = LCD_I2C_TX_BUFFER / 6;
+			while (size > 0) {
+				size_t n = size < perFrame ? size : perFrame;
+				size -= n;
+				_Wire.beginTransmission(_addr);
+				while (n--) {
+					pushByte(*buffer++, PinMap::Rs);
+				}
+				_Wire.endTransmission();
+				delayMicroseconds(50);	// commands need > 37us to settle
+			}
+		}
+
+		void write4bits(uint8_t nibble) {
+			_Wire.beginTransmission(_addr);
+			pushNibble(nibble, 0);
+			_Wire.endTransmission();
+			delayMicroseconds(50);
+		}
+
+		void expanderWrite(uint8_t data) {
+			_Wire.beginTransmission(_addr);
+			_Wire.write(data | _backlightval);
+			_Wire.endTransmission();
+		}
+
+		uint8_t _addr;
+		uint8_t _displayfunction;
+		uint8_t _displaycontrol;
+		uint8_t _displaymode;
+		uint8_t _backlightval;
+		TwoWire& _Wire;
+};
+
+template<uint8_t Cols, uint8_t Rows, class PinMap>
+const uint8_t LiquidCrystal_I2C_T<Cols, Rows, PinMap>::_nibbles[16] PROGMEM = {
+	pack(0x0), pack(0x1), pack(0x2), pack(0x3), pack(0x4), pack(0x5), pack(0x6), pack(0x7),
+	pack(0x8), pack(0x9), pack(0xa), pack(0xb), pack(0xc), pack(0xd), pack(0xe), pack(0xf),
+};
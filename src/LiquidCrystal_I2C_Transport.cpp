@@ -0,0 +1,142 @@
+#include "LiquidCrystal_I2C_Transport.h"
+
+namespace LCD {
+
+	WireTransport::WireTransport(uint8_t addr, TwoWire& wire):
+		_addr(addr),
+		_Wire(wire)
+	{}
+
+	void WireTransport::beginWrite() {
+		_Wire.beginTransmission(_addr);
+	}
+
+	void WireTransport::write(uint8_t data) {
+		_Wire.write((int)(data));
+	}
+
+	void WireTransport::write(const uint8_t* data, size_t size) {
+		_Wire.write(data, size);
+	}
+
+	uint8_t WireTransport::endWrite() {
+		return _Wire.endTransmission();
+	}
+
+	bool WireTransport::read(uint8_t& value) {
+		if (_Wire.requestFrom(_addr, (uint8_t)1) != 1) {
+			return false;
+		}
+		value = _Wire.read();
+		return true;
+	}
+
+	// MCP23017 registers with IOCON.BANK = 0
+	static constexpr uint8_t IODirA = 0x00;
+	static constexpr uint8_t IOConfig = 0x0a;
+	static constexpr uint8_t LatchA = 0x14;
+	static constexpr uint8_t SeqOff = 0x20;	// IOCON.SEQOP: the pointer toggles between A and B
+
+	MCP23017Transport::MCP23017Transport(uint8_t addr, TwoWire& wire):
+		_device(addr, wire)
+	{}
+
+	uint8_t MCP23017Transport::begin() {
+		_device.beginWrite();
+		_device.write(IOConfig);
+		_device.write(SeqOff);
+		uint8_t status = _device.endWrite();
+		if (status != 0) {
+			return status;
+		}
+		_device.beginWrite();
+		_device.write(IODirA);
+		_device.write((uint8_t)0x00);	// IODIRA: all outputs
+		_device.write((uint8_t)0x00);	// IODIRB
+		return _device.endWrite();
+	}
+
+	void MCP23017Transport::beginWrite() {
+		_device.beginWrite();
+		_device.write(LatchA);
+	}
+
+	void MCP23017Transport::write(uint8_t data) {
+		_device.write(data);
+	}
+
+	void MCP23017Transport::write(const uint8_t* data, size_t size) {
+		_device.write(data, size);
+	}
+
+	uint8_t MCP23017Transport::endWrite() {
+		return _device.endWrite();
+	}
+
+	static constexpr uint8_t NoChannel = 0xff;
+
+	I2CMux::I2CMux(uint8_t addr, TwoWire& wire):
+		_addr(addr),
+		_channel(NoChannel),
+		_Wire(wire)
+	{}
+
+	uint8_t I2CMux::select(uint8_t channel) {
+		if (channel == _channel) {
+			return 0;
+		}
+		_Wire.beginTransmission(_addr);
+		_Wire.write((int)(1 << channel));
+		uint8_t status = _Wire.endTransmission();
+		_channel = status == 0 ? channel : NoChannel;
+		return status;
+	}
+
+	void I2CMux::invalidate() {
+		_channel = NoChannel;
+	}
+
+	MuxTransport::MuxTransport(I2CMux& mux, uint8_t channel, uint8_t addr):
+		_mux(mux),
+		_channel(channel),
+		_status(0),
+		_device(addr, mux.wire())
+	{}
+
+	void MuxTransport::beginWrite() {
+		_status = _mux.select(_channel);
+		_device.beginWrite();
+	}
+
+	void MuxTransport::write(uint8_t data) {
+		_device.write(data);
+	}
+
+	void MuxTransport::write(const uint8_t* data, size_t size) {
+		_device.write(data, size);
+	}
+
+	uint8_t MuxTransport::endWrite() {
+		uint8_t status = _device.endWrite();
+		return _status != 0 ? _status : status;
+	}
+
+	bool MuxTransport::read(uint8_t& value) {
+		return _mux.select(_channel) == 0 && _device.read(value);
+	}
+
+	void BufferedTransport::beginWrite() {
+		_size = 0;
+	}
+
+	void BufferedTransport::write(uint8_t data) {
+		if (_size < sizeof(_buffer)) {
+			_buffer[_size++] = data;
+		}
+	}
+
+	uint8_t BufferedTransport::endWrite() {
+		return submit(_buffer, _size);
+	}
+
+} // namespace LCD
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <Arduino.h>
+#include <inttypes.h>
+#include <Wire.h>
+
+// Largest number of bytes one Wire transaction can carry on this platform
+#ifndef LCD_I2C_TX_BUFFER
+	#if defined(I2C_BUFFER_LENGTH)
+		#define LCD_I2C_TX_BUFFER I2C_BUFFER_LENGTH
+	#elif defined(BUFFER_LENGTH)
+		#define LCD_I2C_TX_BUFFER BUFFER_LENGTH
+	#else
+		#define LCD_I2C_TX_BUFFER 32
+	#endif
+#endif
+
+namespace LCD {
+
+	/*!
+	 * @class Transport
+	 * @brief Carries expander bytes from LiquidCrystal_I2C to the backpack.
+	 *
+	 * A transaction is beginWrite(), any number of write() calls up to capacity(), then
+	 * endWrite(). Backends that send in the background (DMA, vendor asynchronous I2C APIs)
+	 * return from endWrite() right away, report busy() until the transfer is done, and call
+	 * completed() from their completion handler.
+	 */
+	class Transport {
+		public:
+			virtual ~Transport() = default;
+
+			/**
+			 * @brief Starts a transaction.
+			 */
+			virtual void beginWrite() = 0;
+
+			/**
+			 * @brief Appends one expander byte to the transaction.
+			 */
+			virtual void write(uint8_t) = 0;
+
+			/**
+			 * @brief Appends several expander bytes to the transaction.
+			 */
+			virtual void write(const uint8_t* data, size_t size) {
+				while (size--) {
+					write(*data++);
+				}
+			}
+
+			/**
+			 * @brief Sends the transaction.
+			 * @return 0 on success, otherwise an error code like TwoWire::endTransmission().
+			 */
+			virtual uint8_t endWrite() = 0;
+
+			/**
+			 * @brief Returns whether a transaction started by endWrite() is still on the wire.
+			 *
+			 * No transaction is started while busy, so the backend may keep using its buffer.
+			 */
+			virtual bool busy() { return false; }
+
+			/**
+			 * @brief Returns the largest number of bytes one transaction can carry.
+			 */
+			virtual size_t capacity() { return LCD_I2C_TX_BUFFER; }
+
+			/**
+			 * @brief Reads the expander port, used for the busy flag.
+			 * @param value  Receives the pin levels.
+			 * @retval true  value is valid.
+			 * @retval false The transport cannot read (default) or the read failed.
+			 */
+			virtual bool read(uint8_t& value) { (void)value; return false; }
+
+			/**
+			 * @brief Returns how many data lines the expander drives.
+			 * @retval 4 One byte per write, D4-D7 and the control pins (PCF8574 default).
+			 * @retval 8 Byte pairs per write: D0-D7, then the control pins (MCP23017).
+			 */
+			virtual uint8_t dataBits() { return 4; }
+
+			/**
+			 * @brief Registers a function to call when a background transfer completes.
+			 *
+			 * Called from the backend's completion handler, possibly in interrupt context;
+			 * use it to wake the task that calls LiquidCrystal_I2C::poll(), not to call it.
+			 */
+			void onComplete(void (*callback)(void*), void* context) {
+				_callback = callback;
+				_context = context;
+			}
+
+		protected:
+			/**
+			 * @brief For backends: reports the end of a background transfer.
+			 */
+			void completed() {
+				if (_callback) {
+					_callback(_context);
+				}
+			}
+
+		private:
+			void (*_callback)(void*) = nullptr;
+			void* _context = nullptr;
+	};
+
+	/*!
+	 * @class WireTransport
+	 * @brief Default transport: a PCF8574 on a TwoWire bus, bytes go straight into the Wire buffer.
+	 */
+	class WireTransport: public Transport {
+		public:
+			WireTransport(uint8_t addr, TwoWire& wire = Wire);
+
+			virtual void beginWrite();
+			virtual void write(uint8_t);
+			virtual void write(const uint8_t*, size_t);
+			virtual uint8_t endWrite();
+			virtual bool read(uint8_t&);
+
+		private:
+			uint8_t _addr;
+			TwoWire& _Wire;
+	};
+
+	/*!
+	 * @class MCP23017Transport
+	 * @brief A 16-bit MCP23017 expander wired for 8-bit mode: D0-D7 on GPA0-GPA7,
+	 * Rs, Rw, En and backlight on GPB0-GPB3 (setPinMap() moves the port B pins).
+	 *
+	 * Every write pair sets OLATA, then OLATB, so a character takes one En pulse.
+	 */
+	class MCP23017Transport: public Transport {
+		public:
+			MCP23017Transport(uint8_t addr = 0x20, TwoWire& wire = Wire);
+
+			/**
+			 * @brief Sets both ports to outputs and byte mode; call before LiquidCrystal_I2C::begin().
+			 * @retval 0 on success, else the endTransmission() status.
+			 */
+			uint8_t begin();
+
+			virtual void beginWrite();
+			virtual void write(uint8_t);
+			virtual void write(const uint8_t*, size_t);
+			virtual uint8_t endWrite();
+			virtual size_t capacity() { return LCD_I2C_TX_BUFFER - 1; }	// the register byte
+			virtual uint8_t dataBits() { return 8; }
+
+		private:
+			WireTransport _device;
+	};
+
+	/*!
+	 * @class I2CMux
+	 * @brief A TCA9548A-style I2C multiplexer; remembers the selected channel.
+	 *
+	 * Shared by the MuxTransports of all displays behind it, so the channel is only
+	 * switched when consecutive transactions go to different channels.
+	 */
+	class I2CMux {
+		public:
+			I2CMux(uint8_t addr = 0x70, TwoWire& wire = Wire);
+
+			/**
+			 * @brief Selects a channel (0~7), unless it is selected already.
+			 * @return 0 on success, otherwise the error code of TwoWire::endTransmission().
+			 */
+			uint8_t select(uint8_t channel);
+
+			/**
+			 * @brief Forgets the selected channel, e.g. after other code switched the mux.
+			 */
+			void invalidate();
+
+			TwoWire& wire() { return _Wire; }
+
+		private:
+			uint8_t _addr;
+			uint8_t _channel;
+			TwoWire& _Wire;
+	};
+
+	/*!
+	 * @class MuxTransport
+	 * @brief A PCF8574 on one channel of an I2CMux.
+	 */
+	class MuxTransport: public Transport {
+		public:
+			MuxTransport(I2CMux& mux, uint8_t channel, uint8_t addr);
+
+			virtual void beginWrite();
+			virtual void write(uint8_t);
+			virtual void write(const uint8_t*, size_t);
+			virtual uint8_t endWrite();
+			virtual bool read(uint8_t&);
+
+		private:
+			I2CMux& _mux;
+			uint8_t _channel;
+			uint8_t _status;	// of the channel switch, reported by endWrite()
+			WireTransport _device;
+	};
+
+	/*!
+	 * @class BufferedTransport
+	 * @brief Base for background backends: collects a transaction in RAM and hands it to submit().
+	 *
+	 * A DMA backend only implements submit(), which starts the transfer of the prebuilt
+	 * buffer, and busy(); its completion handler calls completed().
+	 */
+	class BufferedTransport: public Transport {
+		public:
+			using Transport::write;
+			virtual void beginWrite();
+			virtual void write(uint8_t);
+			virtual uint8_t endWrite();
+			virtual size_t capacity() { return sizeof(_buffer); }
+
+		protected:
+			/**
+			 * @brief Starts sending the transaction; the buffer stays untouched until busy() is false.
+			 * @return 0 if the transfer was started, otherwise an error code.
+			 */
+			virtual uint8_t submit(const uint8_t* data, size_t size) = 0;
+
+		private:
+			uint8_t _buffer[LCD_I2C_TX_BUFFER];
+			size_t _size = 0;
+	};
+
+} // namespace LCD